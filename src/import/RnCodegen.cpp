@@ -0,0 +1,49 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+
+#include "RnCodegen.h"
+
+// Usage: rn_codegen <project.rn> <output.h> [namespace]
+int main(const int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "Usage: rn_codegen <project.rn> <output.h> [namespace]\n");
+    return 1;
+  }
+
+  const auto rn = raynodes::importRN(argv[1]);
+  if (rn.fileData == nullptr) {
+    fprintf(stderr, "Unable to import %s\n", argv[1]);
+    return 1;
+  }
+
+  const auto header = raynodes::GenerateHeader(rn, argc > 3 ? argv[3] : "rn");
+  FILE* file = fopen(argv[2], "wb");
+  if (file == nullptr) {
+    fprintf(stderr, "Unable to open %s\n", argv[2]);
+    return 1;
+  }
+  fwrite(header.data(), 1, header.size(), file);
+  fclose(file);
+
+  printf("Generated %d node types into %s\n", rn.templateCnt, argv[2]);
+  return 0;
+}
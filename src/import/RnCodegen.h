@@ -0,0 +1,307 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RNCODEGEN_H
+#define RNCODEGEN_H
+
+#include <cstdlib>
+
+#include "RnImport.h"
+
+// ==============================
+// CODE GENERATION
+// ==============================
+
+// Generates a header with a typed struct per node template of a ".rn" file
+// Each struct has the template name, component indices (Comp::label), typed members and Decode() / DecodeAll()
+// Component indices resolve at compile time - no more label matching with getComponentData(node, "label")
+// Numbered labels of the same type (Choice1...Choice4) become a single array member (choices[4])
+// ................................................................................................
+// The file only stores component labels - member types are inferred from the saved data of all nodes
+// Integer, float, Vec2 and Vec3 if every node matches - otherwise and without data std::string
+// TEMPLATE_ID is only valid for the file it was generated from - Decode() uses the name instead
+// Usage: rn_codegen <project.rn> <output.h> [namespace]
+
+namespace raynodes {
+inline namespace RN_ABI_NAMESPACE {
+// Returns the generated header for all templates of the import
+std::string GenerateHeader(const RnImport& rn, const char* nameSpace = "rn");
+}  // namespace RN_ABI_NAMESPACE
+}  // namespace raynodes
+
+// ==============================
+// IMPLEMENTATION
+// ==============================
+
+namespace {
+struct _GenMember {
+  std::string label;            // As in the file
+  std::string base;             // Label without trailing digits
+  int number = -1;              // Trailing number or -1
+  raynodes::DataType type = raynodes::STRING;
+  raynodes::ComponentIndex index = 0;
+  int count = 1;  // Array size if grouped
+  std::string name;  // Unique member name in the struct
+};
+// Removes everything that cant be in an identifier
+std::string _gen_identifier(const std::string& label) {
+  std::string result;
+  for (const char ch : label) {
+    if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_') {
+      result.push_back(ch);
+    }
+  }
+  if (result.empty() || (result[0] >= '0' && result[0] <= '9')) result.insert(result.begin(), '_');
+  return result;
+}
+// NPCType -> npcType / DisplayText -> displayText
+std::string _gen_member_name(const std::string& label) {
+  std::string result = _gen_identifier(label);
+  size_t upper = 0;
+  while (upper < result.size() && result[upper] >= 'A' && result[upper] <= 'Z') {
+    upper++;
+  }
+  const size_t lower = upper == result.size() || upper <= 1 ? upper : upper - 1;
+  for (size_t i = 0; i < lower; ++i) {
+    result[i] = static_cast<char>(result[i] - 'A' + 'a');
+  }
+  return result;
+}
+// Keywords and the names the generated code refers to - a struct or member with these names wouldn't compile
+std::vector<std::string> _gen_reserved_names() {
+  return {"alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch",
+          "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr",
+          "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete",
+          "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+          "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+          "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast",
+          "requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct",
+          "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename",
+          "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq", "std",
+          "raynodes", "int64_t", "uint32_t"};
+}
+// Escapes the name for a string literal
+std::string _gen_escape(const std::string& str) {
+  std::string result;
+  for (const char ch : str) {
+    if (ch == '"' || ch == '\\') result.push_back('\\');
+    result.push_back(ch);
+  }
+  return result;
+}
+// Appends a suffix until the name is unused - labels can differ only in stripped characters
+std::string _gen_unique(std::vector<std::string>& used, const std::string& name) {
+  std::string result = name;
+  for (int i = 2; std::ranges::find(used, result) != used.end(); ++i) {
+    result = name + "_" + std::to_string(i);
+  }
+  used.push_back(result);
+  return result;
+}
+// Returns the most specific type that fits the value
+raynodes::DataType _gen_infer_type(const std::string& value) {
+  const char* str = value.c_str();
+  char* end = nullptr;
+  std::strtoll(str, &end, 10);
+  if (end != str && *end == '\0') return raynodes::INTEGER;
+  std::strtod(str, &end);
+  if (end == str) return raynodes::STRING;
+  if (*end == '\0') return raynodes::FLOAT;
+  int parts = 1;
+  while (*end == ';') {
+    const char* next = end + 1;
+    std::strtod(next, &end);
+    if (end == next) return raynodes::STRING;
+    parts++;
+  }
+  if (*end != '\0') return raynodes::STRING;
+  return parts == 2 ? raynodes::VECTOR_2 : parts == 3 ? raynodes::VECTOR_3 : raynodes::STRING;
+}
+// Combines the types of two nodes - integers widen to floats, everything else to strings
+raynodes::DataType _gen_merge_type(const raynodes::DataType a, const raynodes::DataType b) {
+  if (a == b) return a;
+  if ((a == raynodes::INTEGER && b == raynodes::FLOAT) || (a == raynodes::FLOAT && b == raynodes::INTEGER)) {
+    return raynodes::FLOAT;
+  }
+  return raynodes::STRING;
+}
+const char* _gen_type_name(const raynodes::DataType type) {
+  switch (type) {
+    case raynodes::INTEGER:
+      return "int64_t";
+    case raynodes::FLOAT:
+      return "double";
+    case raynodes::VECTOR_2:
+      return "raynodes::Vec2";
+    case raynodes::VECTOR_3:
+      return "raynodes::Vec3";
+    case raynodes::BOOLEAN:
+      return "bool";
+    default:
+      return "std::string";
+  }
+}
+const char* _gen_enum_name(const raynodes::DataType type) {
+  switch (type) {
+    case raynodes::INTEGER:
+      return "raynodes::INTEGER";
+    case raynodes::FLOAT:
+      return "raynodes::FLOAT";
+    case raynodes::VECTOR_2:
+      return "raynodes::VECTOR_2";
+    case raynodes::VECTOR_3:
+      return "raynodes::VECTOR_3";
+    case raynodes::BOOLEAN:
+      return "raynodes::BOOLEAN";
+    default:
+      return "raynodes::STRING";
+  }
+}
+// Component labels of a template line: id|name|label0|label1|...|color|
+std::vector<std::string> _gen_read_labels(const char* fileData, const raynodes::NodeTemplate& nt) {
+  std::vector<std::string> labels;
+  const char* workPtr = fileData + nt.startByte;
+  while (*workPtr != SEPARATOR && *workPtr != '\n' && *workPtr != '\0') {
+    workPtr++;  // Skip the name
+  }
+  for (int i = 0; i < COMPS_PER_NODE && *workPtr == SEPARATOR; ++i) {
+    const char* start = ++workPtr;
+    while (*workPtr != SEPARATOR && *workPtr != '\n' && *workPtr != '\0') {
+      workPtr++;
+    }
+    if (workPtr == start) break;  // Empty labels follow the last component
+    labels.emplace_back(start, workPtr - start);
+  }
+  return labels;
+}
+}  // namespace
+
+namespace raynodes {
+inline namespace RN_ABI_NAMESPACE {
+inline std::string GenerateHeader(const RnImport& rn, const char* nameSpace) {
+  std::string out;
+  out += "// Generated by rn_codegen - do not edit\n\n";
+  out += "#pragma once\n\n#include <string>\n#include <vector>\n\n#include \"RnImport.h\"\n\n";
+  out += "namespace " + std::string(nameSpace) + " {\n";
+
+  std::vector<std::string> structNames = _gen_reserved_names();
+  for (int t = 0; t < rn.templateCnt; ++t) {
+    const auto& nt = rn.templates[t];
+    const std::string name = nt.getName(rn.fileData).getString();
+    const auto nodes = rn.getNodesView(name.c_str());
+
+    // Collect the components and infer their types
+    std::vector<_GenMember> members;
+    const auto labels = _gen_read_labels(rn.fileData, nt);
+    for (size_t i = 0; i < labels.size(); ++i) {
+      _GenMember m;
+      m.label = labels[i];
+      m.index = static_cast<ComponentIndex>(i);
+      size_t digits = m.label.size();
+      while (digits > 0 && m.label[digits - 1] >= '0' && m.label[digits - 1] <= '9') {
+        digits--;
+      }
+      m.base = m.label.substr(0, digits);
+      if (digits < m.label.size() && digits > 0) m.number = std::atoi(m.label.c_str() + digits);
+      bool hasType = false;
+      for (const auto id : nodes) {
+        const auto value = rn.getComponentData<STRING>(id, static_cast<int>(i));
+        if (value.empty()) continue;
+        const auto type = _gen_infer_type(value);
+        m.type = hasType ? _gen_merge_type(m.type, type) : type;
+        hasType = true;
+      }
+      members.push_back(m);
+    }
+
+    // Group consecutive numbered labels with the same base and type
+    std::vector<_GenMember> grouped;
+    for (const auto& m : members) {
+      if (!grouped.empty()) {
+        auto& last = grouped.back();
+        const bool continues = m.number != -1 && last.number != -1 && m.base == last.base && m.type == last.type;
+        if (continues && m.number == last.number + last.count) {
+          last.count++;
+          continue;
+        }
+      }
+      grouped.push_back(m);
+    }
+
+    const std::string structName = _gen_unique(structNames, _gen_identifier(name));
+    // Members share the scope with the fixed declarations and can't be named like their struct
+    std::vector<std::string> memberNames = _gen_reserved_names();
+    memberNames.insert(memberNames.end(),
+                       {structName, "id", "NAME", "HASH", "TEMPLATE_ID", "Comp", "Decode", "DecodeAll"});
+    for (auto& m : grouped) {
+      m.name = _gen_unique(memberNames, m.count > 1 ? _gen_member_name(m.base) + "s" : _gen_member_name(m.label));
+    }
+    std::vector<std::string> compNames = _gen_reserved_names();
+    compNames.emplace_back("Comp");
+
+    out += "\n// Node \"" + _gen_escape(name) + "\"\n";
+    out += "struct " + structName + " {\n";
+    out += "  static constexpr const char* NAME = \"" + _gen_escape(name) + "\";\n";
+    out += "  static constexpr uint32_t HASH = raynodes::StringView::Hash(NAME);\n";
+    out += "  static constexpr raynodes::TemplateID TEMPLATE_ID = " + std::to_string(t) + ";\n";
+    out += "  struct Comp {\n";
+    for (const auto& m : members) {
+      const std::string compName = _gen_unique(compNames, _gen_identifier(m.label));
+      out += "    static constexpr raynodes::ComponentIndex " + compName + " = " + std::to_string(m.index) + ";\n";
+    }
+    out += "  };\n\n";
+
+    out += "  raynodes::NodeID id = raynodes::INVALID_NODE;\n";
+    for (const auto& m : grouped) {
+      if (m.count > 1) {
+        out += "  " + std::string(_gen_type_name(m.type)) + " " + m.name + "[" + std::to_string(m.count) + "]{};\n";
+      } else {
+        out += "  " + std::string(_gen_type_name(m.type)) + " " + m.name + "{};\n";
+      }
+    }
+
+    out += "\n  static " + structName + " Decode(const raynodes::RnImport& rn, const raynodes::NodeID node) {\n";
+    out += "    " + structName + " n;\n";
+    out += "    n.id = node;\n";
+    for (const auto& m : grouped) {
+      for (int i = 0; i < m.count; ++i) {
+        const std::string target = m.count > 1 ? m.name + "[" + std::to_string(i) + "]" : m.name;
+        out += "    n." + target + " = rn.getComponentData<" + _gen_enum_name(m.type) + ">(node, " +
+               std::to_string(m.index + i) + ");\n";
+      }
+    }
+    out += "    return n;\n  }\n";
+    out += "  static std::vector<" + structName + "> DecodeAll(const raynodes::RnImport& rn) {\n";
+    out += "    std::vector<" + structName + "> result;\n";
+    out += "    const auto nodes = rn.getNodesView(NAME);\n";
+    out += "    result.reserve(nodes.size());\n";
+    out += "    for (const auto node : nodes) {\n";
+    out += "      result.push_back(Decode(rn, node));\n";
+    out += "    }\n";
+    out += "    return result;\n  }\n";
+    out += "};\n";
+  }
+  out += "}  // namespace " + std::string(nameSpace) + "\n";
+  return out;
+}
+}  // namespace RN_ABI_NAMESPACE
+}  // namespace raynodes
+
+#endif  //RNCODEGEN_H
@@ -21,10 +21,27 @@
 #ifndef IMPORTER_H
 #define IMPORTER_H
 
+#include <algorithm>
+#include <bit>
+#include <span>
 #include <string>
 #include <vector>
 #include <array>
 #include <cstring>  // for strlen() on gcc
+#include <limits>
+#include <thread>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RN_SSE2
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 // ==============================
 // IMPORT INTERFACE
@@ -38,23 +55,70 @@
 // ................................................................................................
 // It basically just does one pass and saves byte markers where information is stored within the file
 // This later allows for fast, random and frequent access without any more internal allocations
+// Large files can optionally be indexed on multiple threads - the file is split into chunks at line ends
 // ................................................................................................
 // The RnImport interface also abstracts away the fileType so new filetypes like JSON or .csv can be added
 
 // Current memory footprint thats dynamically allocated (bytes):
-// Total Memory = FileSize + nodes * NodeData(8) + connections * ConnectionData(8) + nodeTypes * NodeTemplate(2)
+// Total Memory = FileSize (shared with the page cache with importRNMapped) + nodes * NodeData(8) + connections * ConnectionData(8) + nodeTypes * NodeTemplate(4)
+//                + NodeIndex - (maxNodeID + 1) * 2 if dense / nodes * 2 if sparse (see RnImport::nodeIndex)
+//                + Adjacency - nodes * 4 + connections * 16 (see RnImport::outOffsets)
+//                + Template index - at most nodeTypes * 34 + nodes * 2 (see RnImport::templateTable)
+//                + Full index (optional) - nodes * 28 + fields * 4 (see RnImport::fieldOffsets)
+// With RN_WIDE_IDS: NodeData(16), ConnectionData(12), NodeTemplate(8) and the 2 byte index entries double
+// ................................................................................................
+// Projects with more than 65535 nodes, connections or ids or more than 256 node types are saved in the wide format
+// The wide format is marked in the EditorData (see RN_FORMAT_WIDE) - importing it needs RN_WIDE_IDS
+// Define RN_WIDE_IDS before including this header - wide imports can read both formats
+// Both variants live in their own inline namespace so they can be used in the same program
+
+#define RN_FORMAT_NARROW 1  // Default - no format flag in the file
+#define RN_FORMAT_WIDE 2    // Needs RN_WIDE_IDS
+
+#ifdef RN_WIDE_IDS
+#define RN_ABI_NAMESPACE wide
+#else
+#define RN_ABI_NAMESPACE narrow
+#endif
 
 namespace raynodes {
+inline namespace RN_ABI_NAMESPACE {
+#ifdef RN_WIDE_IDS
+using ByteIndex = uint64_t;      // No practical limit on the fileSize
+using NodeID = uint32_t;         // Limits to 4 billion nodes per project
+using Count = uint32_t;          // Limits nodes, connections and node types
+using TemplateID = uint16_t;     // Limits to 65536 unique nodes
+#else
+using ByteIndex = uint32_t;      // Limits fileSize to 4GB
+using NodeID = uint16_t;         // Limits to 65536 nodes per project
+using Count = uint16_t;          // Limits nodes, connections and node types
+using TemplateID = uint8_t;      // Limits to 256 unique nodes
+#endif
+using ComponentIndex = uint8_t;  // Limits to 256 components per node
+
+// Marks missing nodes - UINT16_MAX or UINT32_MAX with RN_WIDE_IDS
+constexpr NodeID INVALID_NODE = std::numeric_limits<NodeID>::max();
+
 struct RnImport;
 
 // Returns a built import of a ".rn" file as generated from raynodes
 // "path" can be relative (to the current CWD) or absolute
-RnImport importRN(const char* path);
+// Optional: fullIndex records the position of every component field - see RnImport::fieldOffsets
+// Optional: threads > 1 builds the index in parallel on that many threads - 0 uses all hardware threads
+RnImport importRN(const char* path, bool fullIndex = false, int threads = 1);
+
+// Same as importRN but maps the file instead of reading it (POSIX only)
+// The file isnt copied - fileData and all StringViews point into the read only mapping
+// Unused pages can be dropped by the OS and are read again from the file on access
+// Falls back to importRN on Windows or if the file size is a multiple of the page size (no terminating 0 byte)
+RnImport importRNMapped(const char* path, bool fullIndex = false, int threads = 1);
 
 // Returns a buil import of a ".rn" file as generate from raynodes
 // fileData has to be the allocated data of a ".rn" file and fileSize its size
+// Optional: fullIndex records the position of every component field - see RnImport::fieldOffsets
+// Optional: threads > 1 builds the index in parallel on that many threads - 0 uses all hardware threads
 // Failure: Returns a empty import struct with all values either nullptr and 0
-RnImport importRNFromMemory(char* fileData, uint32_t fileSize);
+RnImport importRNFromMemory(char* fileData, ByteIndex fileSize, bool fullIndex = false, int threads = 1);
 
 #define COMPS_PER_NODE 6            // Max components per node
 #define SEPARATOR '\037'            // Set this to the linesep used by cxio (default '\037'  - Unit Separator)
@@ -62,11 +126,6 @@ RnImport importRNFromMemory(char* fileData, uint32_t fileSize);
 #define NEW_LINE_SUB '\036'         // Replaces new line ('\n') in the file ( default '\036' - Record Separator)
 #define RN_MAX_NAME_LEN 16          // Max length of any component or node identifiers
 
-using ByteIndex = uint32_t;      // Limits fileSize to 4GB
-using NodeID = uint16_t;         // Limits to 65536 nodes per project
-using ComponentIndex = uint8_t;  // Limits to 256 components per node
-using TemplateID = uint8_t;      // Limits to 256 unique nodes
-
 // Dont wanna include raylib everywhere
 struct Vec2 {
   float x;
@@ -122,7 +181,7 @@ struct Connection final {
   NodeID toNode;       // Value between 0 and nodeCnt-1 or ]0 - nodeCnt] or (0 - nodeCnt]
   int8_t toComponent;  // -1 if its a node-to-node connection
   uint8_t toPin;
-  [[nodiscard]] bool isValid() const { return fromNode != UINT16_MAX; }
+  [[nodiscard]] bool isValid() const { return fromNode != INVALID_NODE; }
 };
 
 struct NodeData {
@@ -130,12 +189,16 @@ struct NodeData {
   const NodeID id = 0;
   const TemplateID tID = 0;
 
+  // Walks the node line to the field
   template <DataType dt>
   auto getData(char* fileData, ComponentIndex id, int index) const;
+  // Parses the field starting at workPtr
+  template <DataType dt>
+  static auto ParseData(char* workPtr);
 };
 
 struct NodeTemplate {
-  const uint16_t startByte = 0;
+  const ByteIndex startByte = 0;
   ComponentIndex getCompIndex(char* fileData, const char* label) const;
   StringView getName(const char* fileData) const;
   bool isNodeName(const char* fileData, const char* nodeName) const;
@@ -143,26 +206,76 @@ struct NodeTemplate {
 
 // All members are openly accessible to allow custom tinkering - only use them if you know what your doing!
 struct RnImport final {
-  uint16_t templateCnt = 0;           // Amount of templates
+  Count templateCnt = 0;              // Amount of templates
   NodeTemplate* templates = nullptr;  // Node templates
-  uint16_t nodeCnt = 0;               // Amount of nodes
+  Count nodeCnt = 0;                  // Amount of nodes
   NodeData* nodes = nullptr;          // Internal data holder
-  uint16_t connCnt = 0;               // Amount of connections
+  Count connCnt = 0;                  // Amount of connections
   Connection* connections = nullptr;  // Internal data holder
 
-  char* fileData = nullptr;  // Allocated string containing the whole file data
-  uint32_t size = 0;         // Size of fileData
-
-  RnImport(char* fileData, ByteIndex size);
+  // Maps a NodeID to its position in "nodes" - ids can have gaps after nodes were deleted
+  // Dense: indexed by id, INVALID_POS marks unused ids - used if the ids span at most DENSE_FACTOR * nodeCnt
+  // Sparse: positions sorted by id - looked up with a binary search
+  static constexpr int DENSE_FACTOR = 4;
+  // Parallel imports give every thread at least this many bytes - smaller files use fewer threads
+  static constexpr uint32_t PARALLEL_MIN_BYTES = 256 * 1024;
+  static constexpr Count INVALID_POS = std::numeric_limits<Count>::max();
+  Count* nodeIndex = nullptr;
+  size_t nodeIndexCnt = 0;  // Size of nodeIndex
+  bool isDenseIndex = false;
+
+  // Connections grouped by the position of their node in "nodes" (compressed sparse rows)
+  // The connections of the node at position i are [outOffsets[i], outOffsets[i+1]) in connectionsOut
+  // Within a node the file order is kept
+  Count* outOffsets = nullptr;           // nodeCnt + 1 entries
+  Connection* connectionsOut = nullptr;  // Sorted by fromNode
+  Count* inOffsets = nullptr;            // nodeCnt + 1 entries
+  Connection* connectionsIn = nullptr;   // Sorted by toNode
+
+  // Optional full index - the byte offset of every field so reading any field doesnt walk the node line
+  // Component c of the node at position i owns the fields from componentFields[i * 7 + c]
+  // up to (excluding) componentFields[i * 7 + c + 1]
+  // Accesses outside the recorded fields use the walking path - results are the same in both modes
+  uint32_t* componentFields = nullptr;  // nodeCnt * (COMPS_PER_NODE + 1) entries - indices into fieldOffsets
+  ByteIndex* fieldOffsets = nullptr;    // Field starts relative to fileData
+  uint32_t fieldCnt = 0;                // Amount of recorded fields
+
+  // Open addressing table from StringView::Hash of the template name to the template - UINT32_MAX marks empty slots
+  // The nodes of template t are [templateOffsets[t], templateOffsets[t+1]) in templateNodes - in file order
+  struct TemplateSlot {
+    uint32_t hash;
+    uint32_t id;
+  };
+  TemplateSlot* templateTable = nullptr;
+  uint32_t templateTableSize = 0;       // Power of two - at least twice the template count
+  Count* templateOffsets = nullptr;     // templateCnt + 1 entries
+  NodeID* templateNodes = nullptr;      // Node ids grouped by template
+
+  char* fileData = nullptr;  // Allocated string containing the whole file data - read only if isMapped
+  ByteIndex size = 0;        // Size of fileData
+
+  bool isMapped = false;     // fileData is a file mapping (importRNMapped)
+
+  RnImport(char* fileData, ByteIndex size, bool fullIndex = false, int threads = 1, bool isMapped = false);
   RnImport(const RnImport& other) = delete;
   RnImport(RnImport&& other) noexcept = delete;
   RnImport& operator=(const RnImport& other) = delete;
   RnImport& operator=(RnImport&& other) noexcept = delete;
   ~RnImport() {
-    free(fileData);
+    releaseFile();
     free(templates);
     free(nodes);
     free(connections);
+    free(nodeIndex);
+    free(outOffsets);
+    free(connectionsOut);
+    free(inOffsets);
+    free(connectionsIn);
+    free(componentFields);
+    free(fieldOffsets);
+    free(templateTable);
+    free(templateOffsets);
+    free(templateNodes);
   }
 
   // Returns the data of the component with the given label from the node identified by nodeID
@@ -208,13 +321,38 @@ struct RnImport final {
   // Failure: will never fail - vector is empty or filled with valid connections
   [[nodiscard]] std::vector<Connection> getConnectionsIn(NodeID node, int component = -2, int pin = -1) const;
 
+  // Returns all outgoing connections of a node - a view into the internal index without allocating
+  // Failure: returns an empty span if the node doesnt exist or has no outgoing connections
+  [[nodiscard]] std::span<const Connection> getConnectionsOutView(NodeID node) const;
+
+  // Returns all incoming connections of a node - a view into the internal index without allocating
+  // Failure: returns an empty span if the node doesnt exist or has no incoming connections
+  [[nodiscard]] std::span<const Connection> getConnectionsInView(NodeID node) const;
+
+  // Returns all nodes matching the name - a view into the internal index without allocating
+  // Failure: returns an empty span if there is no such node
+  [[nodiscard]] std::span<const NodeID> getNodesView(const char* name) const;
+
+  // Decodes the component at the specified index of every node matching the name into "out" - one pass over the nodes
+  // out[i] belongs to getNodesView(name)[i] - only the first "capacity" values are written
+  // T has to be assignable from the type returned for "dt" (e.g. double or float for FLOAT)
+  // Returns the amount of matching nodes - call with capacity 0 to size the output
+  // Failure: returns 0 if there is no such node or the component index is negative
+  template <DataType dt, typename T>
+  int getComponentColumn(const char* name, int component, T* out, int capacity, int saveIndex = 0) const;
+
+  // Same as above but the component is looked up by its label once for all nodes
+  // Failure: returns 0 if there is no such node or no component with the label
+  template <DataType dt, typename T>
+  int getComponentColumn(const char* name, const char* label, T* out, int capacity, int saveIndex = 0) const;
+
   // Returns an array of nodes matching the name
-  // Failure: array will always be filled - empty values will be UINT16_MAX
+  // Failure: array will always be filled - empty values will be INVALID_NODE
   template <int size>
   [[nodiscard]] std::array<NodeID, size> getNodes(const char* name) const;
 
   // Returns a vector of nodes matching the name
-  // Failure: array will always be filled - empty values will be UINT16_MAX
+  // Failure: array will always be filled - empty values will be INVALID_NODE
   [[nodiscard]] std::vector<NodeID> getNodes(const char* name) const;
 
   // Returns the name of a node as it was registered with
@@ -223,18 +361,42 @@ struct RnImport final {
 
  private:
   [[nodiscard]] const NodeData* getNodeData(const NodeID id) const {
-    if (id >= nodeCnt) [[unlikely]]
-      return nullptr;
-    for (int i = 0; i < nodeCnt; ++i) {
-      if (nodes[i].id == id) return &nodes[i];
+    if (isDenseIndex) [[likely]] {
+      if (id >= nodeIndexCnt) [[unlikely]] { return nullptr; }
+      const Count pos = nodeIndex[id];
+      return pos == INVALID_POS ? nullptr : &nodes[pos];
     }
-    return nullptr;
+    const Count* end = nodeIndex + nodeIndexCnt;
+    const Count* it = std::lower_bound(static_cast<const Count*>(nodeIndex), end, id, [this](const Count pos, const NodeID nodeID) {
+      return nodes[pos].id < nodeID;
+    });
+    if (it == end || nodes[*it].id != id) return nullptr;
+    return &nodes[*it];
+  }
+  [[nodiscard]] int getNodePosition(const NodeID id) const {
+    const auto* nData = getNodeData(id);
+    return nData == nullptr ? -1 : static_cast<int>(nData - nodes);
   }
+  // Parses the node and connection lines in [workPtr, end) - "line" is the index of the first line
+  // Lines count from the first node - line nodeCnt is the connections header
+  void parseLines(char* workPtr, const char* end, int line);
+  void releaseFile();
+  void buildNodeIndex();
+  void buildAdjacency(bool outgoing);
+  void buildFieldIndex(int tasks);
+  // Records the fields of the nodes [from, to) - componentFields are relative to the start of "offsets"
+  void indexFields(int from, int to, std::vector<ByteIndex>& offsets);
+  void buildTemplateIndex();
+  // Returns UINT32_MAX if no template has the given name
+  [[nodiscard]] uint32_t getTemplateID(const char* name) const;
+  template <DataType dt>
+  [[nodiscard]] auto getFieldData(const NodeData* nData, int component, int index) const;
   [[nodiscard]] const NodeTemplate* getNodeTemplate(const TemplateID id) const {
     if (id >= templateCnt) [[unlikely]] { return nullptr; }
     return &templates[id];
   }
 };
+}  // namespace RN_ABI_NAMESPACE
 }  // namespace raynodes
 
 // ==============================
@@ -260,12 +422,66 @@ void _str_read_into_until(const char* data, char* buffer, size_t buffer_size, ch
   }
   buffer[count] = '\0';
 }
-void _str_skip_char(char*& ptr, const char c, int count) noexcept {
+inline void _str_skip_char_scalar(char*& ptr, const char c, int count) noexcept {
   while (*ptr != '\0' && count > 0) {
     if (*ptr == c) { --count; }
     ++ptr;
   }
 }
+#if defined(__AVX2__) || defined(RN_SSE2)
+// Loads are aligned so they never cross into the next page - bytes outside the string are masked out
+// The sanitizer would still report them as out of bounds
+#if defined(__GNUC__) || defined(__clang__)
+#define RN_NO_SANITIZE __attribute__((no_sanitize_address))
+#else
+#define RN_NO_SANITIZE
+#endif
+#if defined(__AVX2__)
+using BlockMask = uint32_t;
+constexpr int BLOCK_SIZE = 32;
+RN_NO_SANITIZE inline BlockMask _block_match(const char* block, const char c) {
+  const __m256i data = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+  return static_cast<BlockMask>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(c))));
+}
+#else
+using BlockMask = uint32_t;
+constexpr int BLOCK_SIZE = 16;
+RN_NO_SANITIZE inline BlockMask _block_match(const char* block, const char c) {
+  const __m128i data = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+  return static_cast<BlockMask>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8(c))));
+}
+#endif
+// Same result as _str_skip_char_scalar - compares a whole block per step
+RN_NO_SANITIZE void _str_skip_char(char*& ptr, const char c, int count) noexcept {
+  if (count <= 0) return;
+  auto* block = reinterpret_cast<char*>(reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(BLOCK_SIZE - 1));
+  BlockMask valid = ~static_cast<BlockMask>(0) << (ptr - block);  // Skip the bytes before ptr
+  while (true) {
+    BlockMask hits = _block_match(block, c) & valid;
+    const BlockMask ends = _block_match(block, '\0') & valid;
+    if (ends != 0) hits &= (ends & (~ends + 1)) - 1;  // Only hits before the terminator
+    const int found = std::popcount(hits);
+    if (found >= count) {
+      for (int i = 1; i < count; ++i) {
+        hits &= hits - 1;  // Clear the lowest hit
+      }
+      ptr = block + std::countr_zero(hits) + 1;
+      return;
+    }
+    if (ends != 0) {
+      ptr = block + std::countr_zero(ends);
+      return;
+    }
+    count -= found;
+    block += BLOCK_SIZE;
+    valid = ~static_cast<BlockMask>(0);
+  }
+}
+#else
+void _str_skip_char(char*& ptr, const char c, const int count) noexcept {
+  _str_skip_char_scalar(ptr, c, count);
+}
+#endif
 int _str_parse_int(const char* str) {
   constexpr int radix = 10;
   if (str == nullptr || *str == '\0') return 0;
@@ -342,17 +558,35 @@ template <raynodes::DataType dt>
     static_assert(dt == raynodes::STRING, "Unsupported PinType");
   }
 }
+// Runs func(task) for all tasks - task 0 on the calling thread and each other one on its own thread
+template <typename Func>
+void _run_parallel(const int tasks, Func&& func) {
+  std::vector<std::thread> workers;
+  workers.reserve(tasks - 1);
+  for (int i = 1; i < tasks; ++i) {
+    workers.emplace_back(func, i);
+  }
+  func(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
 }  // namespace
 
 //-----------HELPER_CLASSES-----------//
 namespace raynodes {
+inline namespace RN_ABI_NAMESPACE {
 template <DataType dt>
 auto NodeData::getData(char* fileData, const ComponentIndex id, const int index) const {
   char* workPtr = fileData + startByte;
   _str_skip_char(workPtr, SEPARATOR, 1);             // Skip the node id
   _str_skip_char(workPtr, COMPONENT_SEPARATOR, id);  // Skipped if component is 0
   _str_skip_char(workPtr, SEPARATOR, index);         // Skipped if index is 0
+  return ParseData<dt>(workPtr);
+}
 
+template <DataType dt>
+auto NodeData::ParseData(char* workPtr) {
   if constexpr (dt == BOOLEAN) {
     return std::strtol(workPtr, nullptr, 10) == 1;
   } else if constexpr (dt == STRING) {
@@ -369,7 +603,7 @@ auto NodeData::getData(char* fileData, const ComponentIndex id, const int index)
   } else if constexpr (dt == STRING_VIEW) {
     return StringView{workPtr, (uint16_t)_str_count_chars_until(workPtr, SEPARATOR, RN_MAX_NAME_LEN)};
   } else if constexpr (dt == INTEGER) {
-    return std::strtoll(workPtr, nullptr, 10);
+    return static_cast<int64_t>(std::strtoll(workPtr, nullptr, 10));
   } else if constexpr (dt == FLOAT) {
     return std::strtod(workPtr, nullptr);
   } else if constexpr (dt == VECTOR_2) {
@@ -389,7 +623,7 @@ inline ComponentIndex NodeTemplate::getCompIndex(char* fileData, const char* lab
   char* workPtr = fileData + startByte;
   _str_skip_char(workPtr, SEPARATOR, 1);
   for (uint8_t i = 0; i < COMPS_PER_NODE; ++i) {
-    if (workPtr[0] == '\n') return UINT8_MAX;  // Dummy value
+    if (workPtr[0] == '\n' || workPtr[0] == SEPARATOR) return UINT8_MAX;  // No more labels - dummy value
     if (_str_cmp_stop_at(label, workPtr, RN_MAX_NAME_LEN, SEPARATOR)) return i;
     _str_skip_char(workPtr, SEPARATOR, 1);
   }
@@ -441,11 +675,13 @@ constexpr uint32_t StringView::Hash(const std::string& s) {
   return _fnv1a_32(s.c_str(), s.size());
 }
 
+}  // namespace RN_ABI_NAMESPACE
 }  // namespace raynodes
 
 //-----------RN_IMPORT-----------//
 namespace raynodes {
-inline RnImport importRN(const char* path) {
+inline namespace RN_ABI_NAMESPACE {
+inline RnImport importRN(const char* path, const bool fullIndex, const int threads) {
   FILE* file = fopen(path, "rb");  // Open in binary mode to avoid text translation
   if (file == nullptr) {
     perror("Failed to open file securely");
@@ -466,6 +702,11 @@ inline RnImport importRN(const char* path) {
   }
 
   auto size = static_cast<size_t>(fileSize);
+  if (size > std::numeric_limits<ByteIndex>::max()) {
+    fprintf(stderr, "File is too big - define RN_WIDE_IDS to import it\n");
+    fclose(file);
+    return {nullptr, 0};
+  }
 
   // Return to the beginning of the file
   if (fseek(file, 0, SEEK_SET) != 0) {
@@ -493,79 +734,293 @@ inline RnImport importRN(const char* path) {
   fclose(file);
 
   // Return the result
-  return {buffer, static_cast<ByteIndex>(size)};
+  return {buffer, static_cast<ByteIndex>(size), fullIndex, threads};
 }
 
-inline RnImport importRNFromMemory(char* fileData, uint32_t fileSize) {
+inline RnImport importRNMapped(const char* path, const bool fullIndex, const int threads) {
+#ifndef _WIN32
+  const int fd = open(path, O_RDONLY);
+  if (fd == -1) {
+    perror("Failed to open file");
+    return {nullptr, 0};
+  }
+
+  struct stat info{};
+  if (fstat(fd, &info) != 0 || info.st_size <= 0 || static_cast<uint64_t>(info.st_size) > std::numeric_limits<ByteIndex>::max()) {
+    close(fd);
+    return importRN(path, fullIndex, threads);
+  }
+
+  // The parser relies on a terminating 0 - the rest of the last page is zero filled
+  const auto size = static_cast<size_t>(info.st_size);
+  if (size % static_cast<size_t>(sysconf(_SC_PAGESIZE)) == 0) {
+    close(fd);
+    return importRN(path, fullIndex, threads);
+  }
+
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // The mapping stays valid
+  if (mapping == MAP_FAILED) {
+    perror("Failed to map file");
+    return importRN(path, fullIndex, threads);
+  }
+
+  return {static_cast<char*>(mapping), static_cast<ByteIndex>(size), fullIndex, threads, true};
+#else
+  return importRN(path, fullIndex, threads);
+#endif
+}
+
+inline RnImport importRNFromMemory(char* fileData, ByteIndex fileSize, const bool fullIndex, const int threads) {
   if (fileData == nullptr || fileSize == 0) return {nullptr, 0};
-  return {fileData, fileSize};
+  return {fileData, fileSize, fullIndex, threads};
 }
 
-inline RnImport::RnImport(char* fileData, ByteIndex size) : fileData(fileData), size(size) {
+inline RnImport::RnImport(char* fileData, ByteIndex size, const bool fullIndex, const int threads, const bool isMapped)
+    : fileData(fileData), size(size), isMapped(isMapped) {
   if (fileData == nullptr) return;
   auto* indexPtr = fileData;
   // Allocating space
   {
     // This is a fixed format header - EditorData will always be 1 line e.g.:
     //--EditorData--
-    //2|1|-145.238|-170.635|0.960|1|
+    //2|1|-145.238|-170.635|0.960|
     //--Templates--
     //10|
+    // Wide files have the format flag after the camera: 2|1|-145.238|-170.635|0.960|2|
 
     _str_skip_char(indexPtr, '\n', 1);
-    nodeCnt = _str_parse_int(indexPtr);
+    const int fileNodes = _str_parse_int(indexPtr);
     _str_skip_char(indexPtr, SEPARATOR, 1);
-    connCnt = _str_parse_int(indexPtr);
+    const int fileConnections = _str_parse_int(indexPtr);
+    int format = RN_FORMAT_NARROW;
+    for (int separators = 0; separators < 4 && *indexPtr != '\n' && *indexPtr != '\0';) {
+      if (*indexPtr++ == SEPARATOR) separators++;
+    }
+    if (*indexPtr != '\n' && *indexPtr != '\0') format = _str_parse_int(indexPtr);
+    if (format > RN_FORMAT_WIDE) fprintf(stderr, "Project was saved with a newer format (%d)\n", format);
+#ifndef RN_WIDE_IDS
+    if (format >= RN_FORMAT_WIDE || fileNodes > UINT16_MAX || fileConnections > UINT16_MAX) {
+      fprintf(stderr, "Project uses the wide format - define RN_WIDE_IDS to import it\n");
+      releaseFile();
+      return;
+    }
+#endif
+    nodeCnt = static_cast<Count>(fileNodes);
+    connCnt = static_cast<Count>(fileConnections);
     _str_skip_char(indexPtr, '\n', 2);
-    templateCnt = _str_parse_int(indexPtr);
+    templateCnt = static_cast<Count>(_str_parse_int(indexPtr));
 
-    nodes = static_cast<NodeData*>(malloc(nodeCnt * sizeof(NodeData)));
-    connections = static_cast<Connection*>(malloc(connCnt * sizeof(Connection)));
+    // Zeroed - lines missing in a truncated file stay empty
+    nodes = static_cast<NodeData*>(calloc(nodeCnt, sizeof(NodeData)));
+    connections = static_cast<Connection*>(calloc(connCnt, sizeof(Connection)));
     templates = static_cast<NodeTemplate*>(malloc(templateCnt * sizeof(NodeTemplate)));
   }
   // Parsing the templates
   {
     _str_skip_char(indexPtr, '\n', 1);  // Skip the template count
-    for (int i = 0; i < templateCnt; ++i) {
+    for (Count i = 0; i < templateCnt; ++i) {
       const int index = _str_parse_int(indexPtr);
       _str_skip_char(indexPtr, SEPARATOR, 1);
-      NodeTemplate nt{static_cast<uint16_t>(indexPtr - fileData)};
+      NodeTemplate nt{static_cast<ByteIndex>(indexPtr - fileData)};
       memcpy(templates + index, &nt, sizeof(NodeTemplate));
       _str_skip_char(indexPtr, '\n', 1);  // Copy cause of const
     }
   }
-  // Parsing the nodes
-  {
-    _str_skip_char(indexPtr, '\n', 1);  // Skip nodes section
-    for (int i = 0; i < nodeCnt; ++i) {
-      const int templateNum = _str_parse_int(indexPtr);
-      _str_skip_char(indexPtr, SEPARATOR, 1);
-      const int nodeID = _str_parse_int(indexPtr);
-      NodeData nd{static_cast<ByteIndex>(indexPtr - fileData), (NodeID)nodeID, (TemplateID)templateNum};
-      memcpy(nodes + i, &nd, sizeof(NodeData));  // Copy cause of const
-      _str_skip_char(indexPtr, '\n', 1);
+  // Parsing the nodes and connections
+  _str_skip_char(indexPtr, '\n', 1);  // Skip nodes section
+  char* end = fileData + size;
+  const int workers = threads > 0 ? threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  const int tasks = std::clamp(static_cast<int>((end - indexPtr) / PARALLEL_MIN_BYTES), 1, workers);
+  if (tasks == 1) {
+    parseLines(indexPtr, end, 0);
+  } else {
+    // Chunks end after a new line - every thread counts its lines to know where its first line belongs
+    std::vector<char*> chunks(tasks + 1, end);
+    chunks[0] = indexPtr;
+    for (int i = 1; i < tasks; ++i) {
+      char* split = std::max(chunks[i - 1], indexPtr + (end - indexPtr) * i / tasks);
+      auto* newLine = static_cast<char*>(std::memchr(split, '\n', end - split));
+      chunks[i] = newLine == nullptr ? end : newLine + 1;
+    }
+    std::vector<int> lines(tasks + 1, 0);
+    _run_parallel(tasks, [&](const int task) {
+      lines[task + 1] = static_cast<int>(std::count(chunks[task], chunks[task + 1], '\n'));
+    });
+    for (int i = 0; i < tasks; ++i) {
+      lines[i + 1] += lines[i];
     }
+    _run_parallel(tasks, [&](const int task) { parseLines(chunks[task], chunks[task + 1], lines[task]); });
   }
-  // Parsing connections
-  {
-    _str_skip_char(indexPtr, '\n', 1);  // Skip connection section
-    for (int i = 0; i < connCnt; ++i) {
-      const int fromNode = _str_parse_int(indexPtr);
-      _str_skip_char(indexPtr, SEPARATOR, 1);
-      const int from = _str_parse_int(indexPtr);
-      _str_skip_char(indexPtr, SEPARATOR, 1);
-      const int out = _str_parse_int(indexPtr);
-      _str_skip_char(indexPtr, SEPARATOR, 1);
-      const int toNode = _str_parse_int(indexPtr);
-      _str_skip_char(indexPtr, SEPARATOR, 1);
-      const int to = _str_parse_int(indexPtr);
-      _str_skip_char(indexPtr, SEPARATOR, 1);
-      const int in = _str_parse_int(indexPtr);
-      connections[i] = {(NodeID)fromNode, (int8_t)from, (uint8_t)out, (NodeID)toNode, (int8_t)to, (uint8_t)in};
-      _str_skip_char(indexPtr, '\n', 1);
+  buildNodeIndex();
+  buildAdjacency(true);
+  buildAdjacency(false);
+  buildTemplateIndex();
+  if (fullIndex) buildFieldIndex(tasks);
+}
+inline void RnImport::releaseFile() {
+  if (fileData == nullptr) return;
+#ifndef _WIN32
+  if (isMapped) munmap(fileData, size);
+  else free(fileData);
+#else
+  free(fileData);
+#endif
+  fileData = nullptr;
+  size = 0;
+}
+inline void RnImport::parseLines(char* workPtr, const char* end, int line) {
+  const int nodeLines = static_cast<int>(nodeCnt);
+  const int lastLine = nodeLines + static_cast<int>(connCnt);
+  while (workPtr < end && line <= lastLine) {
+    if (line < nodeLines) {
+      const int templateNum = _str_parse_int(workPtr);
+      _str_skip_char(workPtr, SEPARATOR, 1);
+      const int nodeID = _str_parse_int(workPtr);
+      NodeData nd{static_cast<ByteIndex>(workPtr - fileData), (NodeID)nodeID, (TemplateID)templateNum};
+      memcpy(nodes + line, &nd, sizeof(NodeData));  // Copy cause of const
+    } else if (line > nodeLines) {  // Line nodeCnt is the connection section header
+      const int fromNode = _str_parse_int(workPtr);
+      _str_skip_char(workPtr, SEPARATOR, 1);
+      const int from = _str_parse_int(workPtr);
+      _str_skip_char(workPtr, SEPARATOR, 1);
+      const int out = _str_parse_int(workPtr);
+      _str_skip_char(workPtr, SEPARATOR, 1);
+      const int toNode = _str_parse_int(workPtr);
+      _str_skip_char(workPtr, SEPARATOR, 1);
+      const int to = _str_parse_int(workPtr);
+      _str_skip_char(workPtr, SEPARATOR, 1);
+      const int in = _str_parse_int(workPtr);
+      connections[line - nodeLines - 1] = {(NodeID)fromNode, (int8_t)from, (uint8_t)out, (NodeID)toNode, (int8_t)to, (uint8_t)in};
+    }
+    _str_skip_char(workPtr, '\n', 1);
+    line++;
+  }
+}
+inline void RnImport::buildNodeIndex() {
+  if (nodeCnt == 0) return;
+  uint64_t maxID = 0;
+  for (Count i = 0; i < nodeCnt; ++i) {
+    maxID = std::max<uint64_t>(maxID, nodes[i].id);
+  }
+
+  isDenseIndex = maxID < static_cast<uint64_t>(nodeCnt) * DENSE_FACTOR;
+  nodeIndexCnt = isDenseIndex ? maxID + 1 : nodeCnt;
+  nodeIndex = static_cast<Count*>(malloc(nodeIndexCnt * sizeof(Count)));
+  if (isDenseIndex) {
+    std::memset(nodeIndex, 255, nodeIndexCnt * sizeof(Count));  // All INVALID_POS
+    for (Count i = 0; i < nodeCnt; ++i) {
+      nodeIndex[nodes[i].id] = static_cast<Count>(i);
+    }
+  } else {
+    for (Count i = 0; i < nodeCnt; ++i) {
+      nodeIndex[i] = static_cast<Count>(i);
+    }
+    std::sort(nodeIndex, nodeIndex + nodeIndexCnt, [this](const Count a, const Count b) {
+      return nodes[a].id < nodes[b].id;
+    });
+  }
+}
+inline void RnImport::buildAdjacency(const bool outgoing) {
+  // Counting sort by node position - stable so the file order is kept
+  auto* offsets = static_cast<Count*>(calloc(nodeCnt + 1, sizeof(Count)));
+  auto* sorted = static_cast<Connection*>(malloc(connCnt * sizeof(Connection)));
+  for (Count i = 0; i < connCnt; ++i) {
+    const int pos = getNodePosition(outgoing ? connections[i].fromNode : connections[i].toNode);
+    if (pos != -1) [[likely]] { offsets[pos + 1]++; }
+  }
+  for (Count i = 0; i < nodeCnt; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+  auto* cursor = static_cast<Count*>(malloc((nodeCnt + 1) * sizeof(Count)));
+  std::memcpy(cursor, offsets, (nodeCnt + 1) * sizeof(Count));
+  for (Count i = 0; i < connCnt; ++i) {
+    const int pos = getNodePosition(outgoing ? connections[i].fromNode : connections[i].toNode);
+    if (pos != -1) [[likely]] { sorted[cursor[pos]++] = connections[i]; }
+  }
+  free(cursor);
+
+  if (outgoing) {
+    outOffsets = offsets;
+    connectionsOut = sorted;
+  } else {
+    inOffsets = offsets;
+    connectionsIn = sorted;
+  }
+}
+inline void RnImport::buildFieldIndex(const int tasks) {
+  constexpr int stride = COMPS_PER_NODE + 1;
+  componentFields = static_cast<uint32_t*>(malloc(nodeCnt * stride * sizeof(uint32_t)));
+  if (tasks == 1 || static_cast<int>(nodeCnt) < tasks) {
+    std::vector<ByteIndex> offsets;
+    offsets.reserve(nodeCnt * 4);
+    indexFields(0, nodeCnt, offsets);
+    fieldCnt = static_cast<uint32_t>(offsets.size());
+    fieldOffsets = static_cast<ByteIndex*>(malloc(fieldCnt * sizeof(ByteIndex)));
+    if (fieldCnt > 0) std::memcpy(fieldOffsets, offsets.data(), fieldCnt * sizeof(ByteIndex));
+    return;
+  }
+
+  // Split the nodes so every task walks about the same amount of bytes
+  std::vector<int> firstNode(tasks + 1, nodeCnt);
+  firstNode[0] = 0;
+  const ByteIndex begin = nodes[0].startByte;
+  for (int i = 1; i < tasks; ++i) {
+    const ByteIndex split = begin + static_cast<ByteIndex>(static_cast<uint64_t>(size - begin) * i / tasks);
+    const auto* it = std::lower_bound(nodes, nodes + nodeCnt, split,
+                                      [](const NodeData& n, const ByteIndex b) { return n.startByte < b; });
+    firstNode[i] = std::max(firstNode[i - 1], static_cast<int>(it - nodes));
+  }
+  std::vector<std::vector<ByteIndex>> offsets(tasks);
+  _run_parallel(tasks, [&](const int task) { indexFields(firstNode[task], firstNode[task + 1], offsets[task]); });
+
+  // Stitching - the fields of a task follow the fields of all previous tasks
+  fieldCnt = 0;
+  for (const auto& taskOffsets : offsets) {
+    fieldCnt += static_cast<uint32_t>(taskOffsets.size());
+  }
+  fieldOffsets = static_cast<ByteIndex*>(malloc(fieldCnt * sizeof(ByteIndex)));
+  uint32_t base = 0;
+  for (int task = 0; task < tasks; ++task) {
+    for (int i = firstNode[task] * stride; i < firstNode[task + 1] * stride; ++i) {
+      componentFields[i] += base;
     }
+    const auto& taskOffsets = offsets[task];
+    if (!taskOffsets.empty()) std::memcpy(fieldOffsets + base, taskOffsets.data(), taskOffsets.size() * sizeof(ByteIndex));
+    base += static_cast<uint32_t>(taskOffsets.size());
   }
 }
+inline void RnImport::indexFields(const int from, const int to, std::vector<ByteIndex>& offsets) {
+  constexpr int stride = COMPS_PER_NODE + 1;
+  for (int i = from; i < to; ++i) {
+    char* workPtr = fileData + nodes[i].startByte;
+    _str_skip_char(workPtr, SEPARATOR, 1);  // Skip the node id
+    uint32_t* fields = componentFields + i * stride;
+    for (int c = 0; c < COMPS_PER_NODE; ++c) {
+      fields[c] = static_cast<uint32_t>(offsets.size());
+      if (*workPtr == '\n' || *workPtr == '\0') continue;
+      // A field starts at the component start and after every separator inside the component
+      offsets.push_back(static_cast<ByteIndex>(workPtr - fileData));
+      while (*workPtr != '\n' && *workPtr != '\0') {
+        const char ch = *workPtr++;
+        if (ch == COMPONENT_SEPARATOR) break;
+        if (ch == SEPARATOR && *workPtr != COMPONENT_SEPARATOR && *workPtr != '\n' && *workPtr != '\0') {
+          offsets.push_back(static_cast<ByteIndex>(workPtr - fileData));
+        }
+      }
+    }
+    fields[COMPS_PER_NODE] = static_cast<uint32_t>(offsets.size());
+  }
+}
+template <DataType dt>
+auto RnImport::getFieldData(const NodeData* nData, const int component, const int index) const {
+  if (componentFields != nullptr && component < COMPS_PER_NODE) [[likely]] {
+    const uint32_t* fields = componentFields + (nData - nodes) * (COMPS_PER_NODE + 1);
+    const uint32_t field = fields[component] + index;
+    if (field < fields[component + 1]) [[likely]] { return NodeData::ParseData<dt>(fileData + fieldOffsets[field]); }
+  }
+  return nData->getData<dt>(fileData, component, index);
+}
 template <DataType dt>
 auto RnImport::getComponentData(const NodeID node, const char* label, const int saveIndex) const {
   if (label == nullptr || saveIndex < 0) [[unlikely]] { return GetDefaultValue<dt>(); }
@@ -575,39 +1030,47 @@ auto RnImport::getComponentData(const NodeID node, const char* label, const int
   if (nTemplate == nullptr) [[unlikely]] { return GetDefaultValue<dt>(); }
   ComponentIndex compIndex = nTemplate->getCompIndex(fileData, label);
   if (compIndex == UINT8_MAX) [[unlikely]] { return GetDefaultValue<dt>(); }
-  return nData->getData<dt>(fileData, compIndex, saveIndex);
+  return getFieldData<dt>(nData, compIndex, saveIndex);
 }
 template <DataType dt>
 auto RnImport::getComponentData(const NodeID node, const int component, const int saveIndex) const {
   if (component < 0 || saveIndex < 0) [[unlikely]] { return GetDefaultValue<dt>(); }
   const auto* nData = getNodeData(node);
   if (nData == nullptr) [[unlikely]] { return GetDefaultValue<dt>(); }
-  return nData->getData<dt>(fileData, component, saveIndex);
+  return getFieldData<dt>(nData, component, saveIndex);
+}
+inline std::span<const Connection> RnImport::getConnectionsOutView(const NodeID node) const {
+  const int pos = getNodePosition(node);
+  if (pos == -1) [[unlikely]] { return {}; }
+  return {connectionsOut + outOffsets[pos], connectionsOut + outOffsets[pos + 1]};
+}
+inline std::span<const Connection> RnImport::getConnectionsInView(const NodeID node) const {
+  const int pos = getNodePosition(node);
+  if (pos == -1) [[unlikely]] { return {}; }
+  return {connectionsIn + inOffsets[pos], connectionsIn + inOffsets[pos + 1]};
 }
 template <int size>
 std::array<Connection, size> RnImport::getConnectionsOut(const NodeID node, const int component, int pin) const {
   int index = 0;
   std::array<Connection, size> retval;
-  for (int i = 0; i < connCnt; ++i) {
-    if (connections[i].fromNode != node) [[likely]] { continue; }
-    if (component != -2 && connections[i].fromComponent != component) [[likely]] { continue; }
-    if (pin != -1 && connections[i].fromPin != pin) [[likely]] { continue; }
-    retval[index++] = connections[i];
+  for (const auto& conn : getConnectionsOutView(node)) {
+    if (component != -2 && conn.fromComponent != component) [[likely]] { continue; }
+    if (pin != -1 && conn.fromPin != pin) [[likely]] { continue; }
+    retval[index++] = conn;
     if (index >= size) [[unlikely]] { break; }
   }
   while (index < size) [[likely]] {
-    retval[index++] = {UINT16_MAX, INT8_MAX, UINT8_MAX, UINT16_MAX, INT8_MAX, UINT8_MAX};
+    retval[index++] = {INVALID_NODE, INT8_MAX, UINT8_MAX, INVALID_NODE, INT8_MAX, UINT8_MAX};
   }
   return retval;
 }
 inline std::vector<Connection> RnImport::getConnectionsOut(NodeID node, int component, int pin) const {
   std::vector<Connection> retval;
   retval.reserve(5);
-  for (int i = 0; i < connCnt; ++i) {
-    if (connections[i].fromNode != node) [[likely]] { continue; }
-    if (component != -2 && connections[i].fromComponent != component) [[likely]] { continue; }
-    if (pin != -1 && connections[i].fromPin != pin) [[likely]] { continue; }
-    retval.push_back(connections[i]);
+  for (const auto& conn : getConnectionsOutView(node)) {
+    if (component != -2 && conn.fromComponent != component) [[likely]] { continue; }
+    if (pin != -1 && conn.fromPin != pin) [[likely]] { continue; }
+    retval.push_back(conn);
   }
   return retval;
 }
@@ -616,15 +1079,14 @@ std::array<Connection, size> RnImport::getConnectionsIn(NodeID node, int compone
   int index = 0;
   std::array<Connection, size> retval;
 
-  for (int i = 0; i < connCnt; ++i) {
-    if (connections[i].toNode != node) [[likely]] { continue; }
-    if (component != -2 && connections[i].toComponent != component) [[likely]] { continue; }
-    if (pin != -1 && connections[i].toPin != pin) [[likely]] { continue; }
-    retval[index++] = connections[i];
+  for (const auto& conn : getConnectionsInView(node)) {
+    if (component != -2 && conn.toComponent != component) [[likely]] { continue; }
+    if (pin != -1 && conn.toPin != pin) [[likely]] { continue; }
+    retval[index++] = conn;
     if (index >= size) [[unlikely]] { break; }
   }
   while (index < size) [[likely]] {
-    retval[index++] = {UINT16_MAX, INT8_MAX, UINT8_MAX, UINT16_MAX, INT8_MAX, UINT8_MAX};
+    retval[index++] = {INVALID_NODE, INT8_MAX, UINT8_MAX, INVALID_NODE, INT8_MAX, UINT8_MAX};
   }
 
   return retval;
@@ -633,57 +1095,99 @@ std::array<Connection, size> RnImport::getConnectionsIn(NodeID node, int compone
 inline std::vector<Connection> RnImport::getConnectionsIn(NodeID node, int component, int pin) const {
   std::vector<Connection> retval;
   retval.reserve(5);
-  for (int i = 0; i < connCnt; ++i) {
-    if (connections[i].toNode != node) [[likely]] { continue; }
-    if (component != -2 && connections[i].toComponent != component) [[likely]] { continue; }
-    if (pin != -1 && connections[i].toPin != pin) [[likely]] { continue; }
-    retval.push_back(connections[i]);
+  for (const auto& conn : getConnectionsInView(node)) {
+    if (component != -2 && conn.toComponent != component) [[likely]] { continue; }
+    if (pin != -1 && conn.toPin != pin) [[likely]] { continue; }
+    retval.push_back(conn);
   }
   return retval;
 }
 
+inline void RnImport::buildTemplateIndex() {
+  if (templateCnt == 0) return;
+  templateTableSize = std::bit_ceil(static_cast<uint32_t>(templateCnt) * 2);
+  templateTable = static_cast<TemplateSlot*>(malloc(templateTableSize * sizeof(TemplateSlot)));
+  std::memset(templateTable, 255, templateTableSize * sizeof(TemplateSlot));  // All ids UINT32_MAX
+  const uint32_t mask = templateTableSize - 1;
+  for (Count i = 0; i < templateCnt; ++i) {
+    const uint32_t hash = templates[i].getName(fileData).getHash();
+    uint32_t slot = hash & mask;
+    while (templateTable[slot].id != UINT32_MAX) {
+      slot = (slot + 1) & mask;
+    }
+    templateTable[slot] = {hash, static_cast<uint32_t>(i)};
+  }
+
+  // Counting sort by template - stable so the file order is kept
+  templateOffsets = static_cast<Count*>(calloc(templateCnt + 1, sizeof(Count)));
+  templateNodes = static_cast<NodeID*>(malloc(nodeCnt * sizeof(NodeID)));
+  for (Count i = 0; i < nodeCnt; ++i) {
+    if (nodes[i].tID < templateCnt) [[likely]] { templateOffsets[nodes[i].tID + 1]++; }
+  }
+  for (Count i = 0; i < templateCnt; ++i) {
+    templateOffsets[i + 1] += templateOffsets[i];
+  }
+  auto* cursor = static_cast<Count*>(malloc(templateCnt * sizeof(Count)));
+  std::memcpy(cursor, templateOffsets, templateCnt * sizeof(Count));
+  for (Count i = 0; i < nodeCnt; ++i) {
+    if (nodes[i].tID < templateCnt) [[likely]] { templateNodes[cursor[nodes[i].tID]++] = nodes[i].id; }
+  }
+  free(cursor);
+}
+inline uint32_t RnImport::getTemplateID(const char* name) const {
+  if (name == nullptr || templateTable == nullptr) [[unlikely]] { return UINT32_MAX; }
+  const uint32_t hash = StringView::Hash(name);
+  const uint32_t mask = templateTableSize - 1;
+  for (uint32_t slot = hash & mask; templateTable[slot].id != UINT32_MAX; slot = (slot + 1) & mask) {
+    const auto [slotHash, id] = templateTable[slot];
+    if (slotHash == hash && templates[id].isNodeName(fileData, name)) [[likely]] { return id; }
+  }
+  return UINT32_MAX;
+}
+inline std::span<const NodeID> RnImport::getNodesView(const char* name) const {
+  const uint32_t id = getTemplateID(name);
+  if (id == UINT32_MAX) return {};
+  return {templateNodes + templateOffsets[id], templateNodes + templateOffsets[id + 1]};
+}
+template <DataType dt, typename T>
+int RnImport::getComponentColumn(const char* name, const int component, T* out, const int capacity,
+                                 const int saveIndex) const {
+  const uint32_t id = getTemplateID(name);
+  if (id == UINT32_MAX || component < 0 || saveIndex < 0) [[unlikely]] { return 0; }
+  const int count = templateOffsets[id + 1] - templateOffsets[id];
+  const int limit = std::min(count, capacity);
+  // Nodes of a template are in file order - same as templateNodes without the id lookup
+  int written = 0;
+  for (Count i = 0; i < nodeCnt && written < limit; ++i) {
+    if (nodes[i].tID != id) continue;
+    out[written++] = getFieldData<dt>(&nodes[i], component, saveIndex);
+  }
+  return count;
+}
+template <DataType dt, typename T>
+int RnImport::getComponentColumn(const char* name, const char* label, T* out, const int capacity,
+                                 const int saveIndex) const {
+  const uint32_t id = getTemplateID(name);
+  if (id == UINT32_MAX || label == nullptr) [[unlikely]] { return 0; }
+  const ComponentIndex compIndex = templates[id].getCompIndex(fileData, label);
+  if (compIndex == UINT8_MAX) [[unlikely]] { return 0; }
+  return getComponentColumn<dt>(name, compIndex, out, capacity, saveIndex);
+}
 template <int size>
 std::array<NodeID, size> RnImport::getNodes(const char* name) const {
-  int index = 0;
   std::array<NodeID, size> retVal;
   std::memset(&retVal, 255, size * sizeof(NodeID));  // Setting all bytes to 1's -> biggest possible value
-  if (name == nullptr) return retVal;
-  TemplateID id = UINT8_MAX;
-  for (int i = 0; i < templateCnt; ++i) {
-    if (templates[i].isNodeName(fileData, name)) [[unlikely]] {
-      id = static_cast<uint8_t>(i);
-      break;
-    }
-  }
-  if (id == UINT8_MAX) return retVal;
-  for (int i = 0; i < nodeCnt; ++i) {
-    if (nodes[i].tID == id) [[unlikely]] {
-      retVal[index++] = nodes[i].id;
-      if (index >= size) break;
-    }
-  }
+  const auto view = getNodesView(name);
+  std::copy_n(view.begin(), std::min<size_t>(view.size(), size), retVal.begin());
   return retVal;
 }
 
 inline std::vector<NodeID> RnImport::getNodes(const char* name) const {
-  std::vector<NodeID> retVal;
-  if (name == nullptr) return retVal;
-  TemplateID id = UINT8_MAX;
-  for (int i = 0; i < templateCnt; ++i) {
-    if (templates[i].isNodeName(fileData, name)) [[unlikely]] {
-      id = static_cast<uint8_t>(i);
-      break;
-    }
-  }
-  if (id == UINT8_MAX) return retVal;
-  for (int i = 0; i < nodeCnt; ++i) {
-    if (nodes[i].tID == id) [[unlikely]] { retVal.push_back(nodes[i].id); }
-  }
-  return retVal;
+  const auto view = getNodesView(name);
+  return {view.begin(), view.end()};
 }
 
 inline StringView RnImport::getNodeName(NodeID node) const {
-  if (node >= nodeCnt) [[unlikely]] { return {}; }
   const auto* nData = getNodeData(node);
   if (nData == nullptr) [[unlikely]] { return {}; }
   const auto* nTemplate = getNodeTemplate(nData->tID);
@@ -692,5 +1196,6 @@ inline StringView RnImport::getNodeName(NodeID node) const {
   return nTemplate->getName(fileData);
 }
 
+}  // namespace RN_ABI_NAMESPACE
 }  // namespace raynodes
 #endif  //IMPORTER_H
\ No newline at end of file
@@ -142,6 +142,15 @@ struct MathC final : Component {
     cxstructs::io_load(file, selectedMode);
     dropDown.selectedIndex = selectedMode;
   }
+  void load(ByteReader& reader) override {
+    cxstructs::io_load(reader, selectedMode);
+    dropDown.selectedIndex = selectedMode;
+  }
+  void save(BinaryWriter& writer) override { writer.writeInt(selectedMode); }
+  void load(BinaryReader& reader) override {
+    selectedMode = static_cast<int>(reader.readInt());
+    dropDown.selectedIndex = selectedMode;
+  }
 
   static double performOperation(double x, double y, MOperation op) {
     switch (op) {
@@ -117,6 +117,15 @@ class NumberFieldC final : public Component {
     cxstructs::io_load(file, textField.buffer);
     textField.updateDimensions();
   }
+  void load(ByteReader& reader) override {
+    cxstructs::io_load(reader, textField.buffer);
+    textField.updateDimensions();
+  }
+  void save(BinaryWriter& writer) override { writer.writeString(textField.buffer); }
+  void load(BinaryReader& reader) override {
+    textField.buffer = reader.readString();
+    textField.updateDimensions();
+  }
 
   const char* getString() override { return textField.buffer.c_str(); }
 };
@@ -85,6 +85,7 @@ struct TextFieldC final : Component {
 
   void onCreate(EditorContext& ec, Node& /**/) override {
     internalLabel = false;  //We don't want to draw our label
+    isSource = true;        //Text can change without focus (undo, paste)
     textField.font = &ec.display.editorFont;
     textField.fs = ec.display.fontSize;
 
@@ -98,6 +99,15 @@ struct TextFieldC final : Component {
     cxstructs::io_load(file, textField.buffer);
     textField.updateDimensions();
   }
+  void load(ByteReader& reader) override {
+    cxstructs::io_load(reader, textField.buffer);
+    textField.updateDimensions();
+  }
+  void save(BinaryWriter& writer) override { writer.writeString(textField.buffer); }
+  void load(BinaryReader& reader) override {
+    textField.buffer = reader.readString();
+    textField.updateDimensions();
+  }
 
   const char* getString() override { return textField.buffer.c_str(); }
 };
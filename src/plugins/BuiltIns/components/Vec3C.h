@@ -126,6 +126,23 @@ struct Vec3C final : Component {
       cxstructs::str_embed_num(textFields[i].buffer, floats[i]);
     }
   }
+  void load(ByteReader& reader) override {
+    float floats[FLOAT_FIELDS];
+    cxstructs::io_load(reader, floats[0], floats[1], floats[2]);
+    for (int i = 0; i < FLOAT_FIELDS; ++i) {
+      cxstructs::str_embed_num(textFields[i].buffer, floats[i]);
+    }
+  }
+  void save(BinaryWriter& writer) override {
+    for (int i = 0; i < FLOAT_FIELDS; ++i) {
+      writer.writeFloat(cxstructs::str_parse_float(textFields[i].buffer.c_str()));
+    }
+  }
+  void load(BinaryReader& reader) override {
+    for (int i = 0; i < FLOAT_FIELDS; ++i) {
+      cxstructs::str_embed_num(textFields[i].buffer, reader.readFloat());
+    }
+  }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,274 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef COMPILEDCIRCUIT_H
+#define COMPILEDCIRCUIT_H
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <unordered_map>
+
+#include "application/EditorContext.h"
+
+// Lowers a graph made only of Logic nodes to a flat instruction list
+// Every value is a group of 64-bit words with one bit per input vector - simulating LANES vectors in one run
+// The word loops are plain so the compiler can vectorize them (SSE2 / AVX2 when enabled)
+//
+// Inputs are all Bool nodes without a connected input - ordered by node id
+// Outputs are all Bool Displays and input only Bools - ordered by node id
+//
+// Results describe the settled state: a connected Bool is a plain copy here and settles in the same run,
+// while in the editor it forwards its value one tick later - the editor reaches the same values after a few ticks
+// Circuits that oscillate have no settled state and settle() reports them
+//
+// Errors are not printed - compile() and truthTable() set "error" and the caller decides how to report it
+struct CompiledCircuit {
+  static constexpr int WORDS = 4;
+  static constexpr int LANES = WORDS * 64;
+  static constexpr int MAX_TABLE_INPUTS = 24;
+
+  using Word = uint64_t;
+  struct Lanes {
+    Word words[WORDS];
+  };
+
+  enum OpCode : uint8_t { AND, OR, XOR, EQUAL, NAND, NOR, NOT, COPY };
+  struct Instruction {
+    OpCode op;
+    uint32_t dst;
+    uint32_t a;
+    uint32_t b;
+  };
+
+  std::vector<Instruction> instructions;
+  std::vector<Lanes> values;      // Slot 0 is the constant false for unconnected inputs
+  std::vector<uint32_t> inputs;   // Slots set from the outside
+  std::vector<uint32_t> outputs;  // Slots read from the outside
+  std::vector<Node*> inputNodes;
+  std::vector<Node*> outputNodes;
+  bool hasFeedback = false;  // Some instruction reads a value written later in the list
+  const char* error = nullptr;       // Set when compile() or truthTable() fails
+  const Node* rejectedNode = nullptr;  // The node compile() stopped at
+
+  // Returns false if the graph contains anything else than gates, bools and displays
+  bool compile(EditorContext& ec) {
+    instructions.clear();
+    values.assign(1, Lanes{});
+    inputs.clear();
+    outputs.clear();
+    inputNodes.clear();
+    outputNodes.clear();
+    hasFeedback = false;
+    error = nullptr;
+    rejectedNode = nullptr;
+
+    std::vector<Node*> sorted = ec.core.nodes;
+    std::ranges::sort(sorted, [](const Node* n1, const Node* n2) { return n1->uID < n2->uID; });
+
+    // Assign a slot for every output pin first - allows reading values that are written later
+    std::unordered_map<const OutputPin*, uint32_t> slots;
+    for (const auto n : sorted) {
+      if (n->components.size() != 1) return reject(n);
+      Component* c = n->components[0];
+      if (GetKind(c) == UNSUPPORTED) return reject(n);
+      if (c->outputs.size() == 1) {
+        slots.insert({&c->outputs[0], static_cast<uint32_t>(values.size())});
+        values.push_back(Lanes{});
+      }
+    }
+
+    const auto slotOf = [&slots](InputPin& in) -> uint32_t {
+      if (!in.isConnected() || in.pinType != BOOLEAN) return 0;
+      const auto it = slots.find(&in.connection->out);
+      return it == slots.end() ? 0 : it->second;
+    };
+
+    for (const auto n : sorted) {
+      Component* c = n->components[0];
+      const auto kind = GetKind(c);
+      if (kind == BOOL && !c->inputs[0].isConnected()) {
+        inputs.push_back(slots[&c->outputs[0]]);
+        inputNodes.push_back(n);
+      } else if (kind == BOOL_OUT) {
+        inputs.push_back(slots[&c->outputs[0]]);
+        inputNodes.push_back(n);
+      } else if (kind == DISPLAY) {
+        outputs.push_back(slots[&c->outputs[0]]);
+        outputNodes.push_back(n);
+      } else if (kind == BOOL_IN) {
+        outputs.push_back(slotOf(c->inputs[0]));
+        outputNodes.push_back(n);
+      }
+    }
+
+    // Instructions follow the editor update order
+    std::vector<bool> written(values.size(), false);
+    written[0] = true;
+    for (const auto i : inputs) {
+      written[i] = true;
+    }
+    for (const auto n : ec.core.getUpdateOrder()) {
+      Component* c = n->components[0];
+      const auto kind = GetKind(c);
+      if (kind == BOOL_IN || kind == BOOL_OUT) continue;
+      if (kind == BOOL && !c->inputs[0].isConnected()) continue;
+
+      Instruction ins{};
+      ins.dst = slots[&c->outputs[0]];
+      ins.a = slotOf(c->inputs[0]);
+      ins.b = c->inputs.size() > 1 ? slotOf(c->inputs[1]) : 0;
+      ins.op = kind == BOOL || kind == DISPLAY ? COPY : static_cast<OpCode>(kind);
+      hasFeedback = hasFeedback || !written[ins.a] || !written[ins.b];
+      written[ins.dst] = true;
+      instructions.push_back(ins);
+    }
+    return true;
+  }
+
+  // Executes the instruction list once for all lanes
+  void run() {
+    Lanes* v = values.data();
+    for (const auto [op, dst, a, b] : instructions) {
+      Word* d = v[dst].words;
+      const Word* x = v[a].words;
+      const Word* y = v[b].words;
+      switch (op) {
+        case AND:
+          for (int i = 0; i < WORDS; ++i) d[i] = x[i] & y[i];
+          break;
+        case OR:
+          for (int i = 0; i < WORDS; ++i) d[i] = x[i] | y[i];
+          break;
+        case XOR:
+          for (int i = 0; i < WORDS; ++i) d[i] = x[i] ^ y[i];
+          break;
+        case EQUAL:
+          for (int i = 0; i < WORDS; ++i) d[i] = ~(x[i] ^ y[i]);
+          break;
+        case NAND:
+          for (int i = 0; i < WORDS; ++i) d[i] = ~(x[i] & y[i]);
+          break;
+        case NOR:
+          for (int i = 0; i < WORDS; ++i) d[i] = ~(x[i] | y[i]);
+          break;
+        case NOT:
+          for (int i = 0; i < WORDS; ++i) d[i] = ~x[i];
+          break;
+        case COPY:
+          for (int i = 0; i < WORDS; ++i) d[i] = x[i];
+          break;
+      }
+    }
+  }
+
+  // Runs until no value changes anymore - a single run for circuits without feedback
+  // Returns false if the circuit oscillates
+  bool settle() {
+    if (!hasFeedback) [[likely]] {
+      run();
+      return true;
+    }
+    std::vector<Lanes> previous;
+    for (size_t i = 0; i <= instructions.size(); ++i) {
+      previous = values;
+      run();
+      if (std::memcmp(previous.data(), values.data(), values.size() * sizeof(Lanes)) == 0) return true;
+    }
+    return false;
+  }
+
+  void setInput(const int input, const Lanes& lanes) { values[inputs[input]] = lanes; }
+  [[nodiscard]] const Lanes& getOutput(const int output) const { return values[outputs[output]]; }
+
+  // Evaluates all 2^inputs combinations - in row r input i is set to bit i of r
+  // Returns a bitset of all rows for each output - empty columns if there are more than MAX_TABLE_INPUTS inputs
+  std::vector<std::vector<Word>> truthTable() {
+    std::vector<std::vector<Word>> table(outputs.size());
+    const int inputCount = static_cast<int>(inputs.size());
+    if (inputCount > MAX_TABLE_INPUTS) {
+      error = "Too many inputs for a truth table";
+      return table;
+    }
+
+    const uint64_t rows = 1ULL << inputCount;
+    const uint64_t rowWords = (rows + 63) / 64;
+    for (auto& column : table) {
+      column.assign(rowWords, 0);
+    }
+
+    for (uint64_t start = 0; start < rows; start += LANES) {
+      for (int i = 0; i < inputCount; ++i) {
+        setInput(i, GetInputPattern(i, start));
+      }
+      settle();
+      for (size_t o = 0; o < outputs.size(); ++o) {
+        const auto& out = getOutput(static_cast<int>(o));
+        for (int w = 0; w < WORDS && start / 64 + w < rowWords; ++w) {
+          table[o][start / 64 + w] = out.words[w];
+        }
+      }
+    }
+
+    // Mask rows that don't exist
+    if (rows < 64) {
+      for (auto& column : table) {
+        column[0] &= (1ULL << rows) - 1;
+      }
+    }
+    return table;
+  }
+
+ private:
+  // Values match the opcodes for the gates
+  enum Kind : uint8_t { K_AND, K_OR, K_XOR, K_EQUAL, K_NAND, K_NOR, K_NOT, BOOL, BOOL_IN, BOOL_OUT, DISPLAY, UNSUPPORTED };
+
+  static Kind GetKind(const Component* c) {
+    constexpr std::pair<const char*, Kind> kinds[] = {
+        {"L_And", K_AND},   {"L_Or", K_OR},          {"L_Xor", K_XOR},           {"L_Equal", K_EQUAL},
+        {"L_Nand", K_NAND}, {"L_Nor", K_NOR},        {"L_Not", K_NOT},           {"L_Bool", BOOL},
+        {"L_Bool_In", BOOL_IN}, {"L_Bool_Out", BOOL_OUT}, {"L_Display", DISPLAY},
+    };
+    for (const auto& [name, kind] : kinds) {
+      if (strcmp(c->id, name) == 0) return kind;
+    }
+    return UNSUPPORTED;
+  }
+
+  bool reject(const Node* n) {
+    error = "Cannot compile circuit - unsupported node";
+    rejectedNode = n;
+    return false;
+  }
+
+  // Row r of the lanes starting at "start" gets bit "input" of r
+  static Lanes GetInputPattern(const int input, const uint64_t start) {
+    constexpr Word patterns[6] = {0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+                                  0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+    Lanes lanes{};
+    for (int w = 0; w < WORDS; ++w) {
+      if (input < 6) lanes.words[w] = patterns[input];
+      else lanes.words[w] = ((start + w * 64) >> input) & 1 ? ~0ULL : 0ULL;
+    }
+    return lanes;
+  }
+};
+
+#endif  //COMPILEDCIRCUIT_H
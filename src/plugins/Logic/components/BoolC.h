@@ -26,6 +26,7 @@ struct BoolC final : Component {
   }
 
   void onCreate(EditorContext& ec, Node& parent) override {
+    isSource = true;  // Can be switched at any time
     if constexpr (style == IN_AND_OUT || style == INPUT_ONLY) { addPinInput(BOOLEAN); }
     if constexpr (style == IN_AND_OUT || style == OUTPUT_ONLY) { addPinOutput(BOOLEAN); }
     const auto [x, y, width, height] = getBounds();
@@ -36,18 +36,21 @@ struct ClockC final : Component {
       activeSwitch.update(ec, ec.logic.worldMouse);
     }
 
-    if (activeSwitch.isActive()) { delayBuilder += 1000.0F / START_FPS; }
+    // Simulated time - independent of the frame rate
+    if (activeSwitch.isActive()) { delayBuilder += ec.core.stepMillis; }
 
-    if (static_cast<int>(delayBuilder) >= delayMillis) {
+    if (delayBuilder >= static_cast<float>(delayMillis)) {
       currentState = !currentState;
       outputs[0].setData<BOOLEAN>(currentState);
-      delayBuilder = 0.0F;
+      // Keep the remainder so the period doesn't drift with the tick rate
+      delayBuilder = delayMillis > 0 ? delayBuilder - static_cast<float>(delayMillis) : 0.0F;
     }
     if (ec.input.isMBPressed(MOUSE_BUTTON_LEFT)) delayField.onFocusGain(ec.logic.worldMouse);
     delayField.update(ec, ec.logic.worldMouse);
   }
 
   void onCreate(EditorContext& ec, Node& parent) override {
+    isSource = true;  // Time based
     const auto [x, y, width, height] = getBounds();
     activeSwitch.bounds = {x, y, 40, height};
     delayField.bounds = {x + 50, y, 80, height};
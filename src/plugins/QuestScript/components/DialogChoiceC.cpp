@@ -80,4 +80,17 @@ void DialogChoiceC::save(FILE* file) {
 void DialogChoiceC::load(FILE* file) {
   cxstructs::io_load(file, textField.buffer);
   textField.updateDimensions();
+}
+void DialogChoiceC::load(ByteReader& reader) {
+  cxstructs::io_load(reader, textField.buffer);
+  textField.updateDimensions();
+}
+
+void DialogChoiceC::save(BinaryWriter& writer) {
+  writer.writeString(textField.buffer);
+}
+
+void DialogChoiceC::load(BinaryReader& reader) {
+  textField.buffer = reader.readString();
+  textField.updateDimensions();
 }
\ No newline at end of file
@@ -34,7 +34,10 @@ class DialogChoiceC final : public Component {
   void draw(EditorContext& ec, Node& parent) override;
   void update(EditorContext&, Node& parent) override;
   void load(FILE* file) override;
+  void load(ByteReader& reader) override;
   void save(FILE* file) override;
+  void load(BinaryReader& reader) override;
+  void save(BinaryWriter& writer) override;
   void onFocusGain(EditorContext&) override;
   void onFocusLoss(EditorContext&) override;
   void onCreate(EditorContext& ec, Node& parent) override;
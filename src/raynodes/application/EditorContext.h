@@ -29,7 +29,10 @@
 #pragma warning(push)
 #pragma warning(disable : 4251)  // Remove export warning
 
+#include <algorithm>
 #include <deque>
+#include <future>
+#include <span>
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -42,6 +45,7 @@
 
 #include "blocks/Connection.h"
 #include "blocks/NodeGroup.h"
+#include "blocks/SpatialGrid.h"
 #include "node/Node.h"
 
 #include "context/ContextInfo.h"
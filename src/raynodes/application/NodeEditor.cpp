@@ -37,6 +37,7 @@
 #include "application/editor/EditorDraw.h"
 
 NodeEditor::NodeEditor(const int argc, char* argv[]) : context(argc, argv) {
+  context.persist.useJournal = true;  // Crash recovery is only for the interactive editor
   Editor::SetupDisplay(context);
   Editor::SetupCamera(context);
 }
@@ -51,7 +52,7 @@ bool NodeEditor::start() {
   c + context.ui.loadUI(context);
 
   // Only load file if path is given - automatically opens picker
-  if (!context.persist.openedFilePath.empty()) c + context.persist.importProject(context);
+  if (!context.persist.openedFilePath.empty()) c + context.persist.importProject(context, true);
 
   return c.holds();
 }
@@ -21,24 +21,45 @@
 #ifndef RAYNODES_SRC_APPLICATION_CONTEXT_CONTEXTCORE_H_
 #define RAYNODES_SRC_APPLICATION_CONTEXT_CONTEXTCORE_H_
 
+// Maps a stable slot to the dense connections index
+struct ConnectionSlot {
+  uint32_t index;
+  uint32_t generation;
+};
+
 struct EXPORT Core final {
   static constexpr int TARGET_FPS = 100;
-  static constexpr int MAX_ACTIONS = 25;
+  static constexpr int MAX_ACTIONS = 10000;  // The history is limited by historyBudget first
+  static constexpr float MAX_FRAME_TIME = 0.25F;  // Skips simulation time after stalls instead of catching up
 
   std::unordered_map<NodeID, Node*> selectedNodes;
   std::unordered_map<NodeID, Node*> nodeMap;
   std::deque<Action*> actionQueue;
   std::vector<Node*> nodes;
+  std::vector<Node*> updateOrder;  // Nodes in dependency order - rebuilt lazily when the graph changes
   std::vector<Node*> copiedNodes;
-  std::vector<Connection*> connections;
+  std::vector<Connection*> connections;  // Dense for iteration - order is not stable
+  std::vector<ConnectionSlot> connectionSlots;
+  std::vector<uint32_t> freeSlots;
+  std::unordered_map<const Node*, std::vector<Connection*>> nodeConnections;  // Incoming and outgoing per node
   std::vector<NodeGroup> nodeGroups;
+  SpatialGrid grid;  // Nodes by position - for culling and picking
 
+  uint64_t simulationTick = 0;
+  float tickRate = START_FPS;    // Simulation ticks per second - independent of the frame rate
+  float tickAccumulator = 0.0F;  // Time not yet simulated in seconds
+  float stepMillis = 0.0F;       // Simulated time of the current evaluation - 0 if no tick is due
   int drawTickTime = 0;
   int currentActionIndex = -1;
-  NodeID UID = static_cast<NodeID>(0);  // Starts with 0 so UINT16_MAX is the sentinel value
+  size_t historyBudget = 32 * 1024 * 1024;  // Bytes of undo history - old actions are compacted, then dropped
+  size_t historyBytes = 0;  // Memory of all actions in the queue
+  int historyChecked = 1;   // Deletions before this index are compacted or still referenced
+  uint32_t nextZIndex = 0;  // Draw order of the next inserted node
+  NodeID UID = static_cast<NodeID>(0);  // Starts with 0 so UINT32_MAX is the sentinel value
   bool hasUnsavedChanges = false;
   bool closeApplication = false;
   bool requestedClose = false;
+  bool isOrderDirty = true;  // Set whenever nodes or connections change
 
   // Needed because of the nodeGroups vector
   Core() = default;
@@ -61,12 +82,15 @@ struct EXPORT Core final {
     if (it != nodeMap.end()) return it->second;
     return nullptr;
   }
-  Node* createAddNode(EditorContext& ec, const char* name, Vector2 worldPos, uint16_t hint = UINT16_MAX);
+  Node* createAddNode(EditorContext& ec, const char* name, Vector2 worldPos, uint32_t hint = UINT32_MAX);
   void insertNode(EditorContext& ec, Node& node);
   void removeNode(EditorContext& ec, NodeID id);
+  void removeNodes(EditorContext& ec, std::span<Node* const> targets);  // Single pass over the node list
   void moveToFront(Node* node) {
     std::erase(nodes, node);
     nodes.push_back(node);
+    node->zIndex = nextZIndex++;
+    isOrderDirty = true;
   }  //Unused
 
   //-----------Shortcuts-----------//
@@ -79,29 +103,41 @@ struct EXPORT Core final {
   void newFile(EditorContext& ec);
 
   //-------------Connections--------------//
-  void removeConnection(Connection* conn) {
-    conn->close();
-    std::erase(connections, conn);
+  void removeConnection(Connection* conn);
+  void addConnection(Connection* conn);
+  // Removes all connections of the given nodes - linear in the removed connections
+  void removeConnectionsFromNodes(std::span<Node* const> targets, std::vector<Connection*>& collector);
+  void removeConnectionsFromNode(Node& node, std::vector<Connection*>& collector) {
+    Node* const target = &node;
+    removeConnectionsFromNodes({&target, 1}, collector);
   }
-  void addConnection(Connection* conn) {
-    conn->open();
-    connections.push_back(conn);
+  // All incoming and outgoing connections of the node
+  [[nodiscard]] const std::vector<Connection*>& getConnections(const Node& node) const;
+  [[nodiscard]] ConnectionHandle getHandle(const Connection& conn) const {
+    if (conn.slot == UINT32_MAX) return {};
+    return {conn.slot, connectionSlots[conn.slot].generation};
+  }
+  [[nodiscard]] Connection* getConnection(const ConnectionHandle handle) const {
+    if (handle.slot >= connectionSlots.size()) return nullptr;
+    const auto [index, generation] = connectionSlots[handle.slot];
+    if (generation != handle.generation || index == UINT32_MAX) return nullptr;
+    return connections[index];
   }
-  //Optimized delete method to remove multiple connections
-  void removeConnectionsFromNode(Node& node, std::vector<Connection*>& collector) {
-    const auto newEnd =
-        std::remove_if(connections.begin(), connections.end(), [&node, &collector](Connection* conn) {
-          if (&conn->fromNode == &node || &conn->toNode == &node) {
-            conn->close();
-            collector.push_back(conn);
-            return true;
-          }
-          return false;
-        });
 
-    // Erase the removed elements
-    connections.erase(newEnd, connections.end());
+  //-------------Evaluation--------------//
+  // Every node comes after all nodes it receives data from - nodes inside a feedback loop are kept together
+  // Unconnected nodes keep the reverse draw order to correctly reflect input layers
+  const std::vector<Node*>& getUpdateOrder() {
+    if (isOrderDirty) [[unlikely]] { buildUpdateOrder(); }
+    return updateOrder;
   }
+  void buildUpdateOrder();
+  // Returns how many simulation ticks are due after the given frame time
+  int advanceTime(float frameTime);
+  // Evaluates all nodes once in dependency order without handling input
+  void simulateTick(EditorContext& ec);
+  // Interactive update of all nodes plus the simulation ticks due after the frame time - returns the ticks
+  int updateNodes(EditorContext& ec, float frameTime);
 
   //-------------EditorActions--------------//
   void addEditorAction(EditorContext& ec, Action* action);
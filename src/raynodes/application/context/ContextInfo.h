@@ -24,8 +24,13 @@
 struct EXPORT Info final {
   static constexpr auto applicationName = "raynodes";
   static constexpr auto fileEnding = ".rn";
-  static constexpr const char* fileFilter[1] = {"*.rn"};
-  static constexpr auto fileDescription = "raynodes save (.rn)";
+  static constexpr auto binaryFileEnding = ".rnb";  // Compact binary format - chosen by the file ending
+  static constexpr auto journalEnding = ".journal";  // Changes since the last save - next to the project file
+  // Format flag in the EditorData of ".rn" files - the narrow format is written whenever the project fits
+  static constexpr int fileFormatNarrow = 1;  // Less than 65535 nodes, connections and ids and up to 256 node types
+  static constexpr int fileFormatWide = 2;    // Needs RN_WIDE_IDS in RnImport
+  static constexpr const char* fileFilter[2] = {"*.rn", "*.rnb"};
+  static constexpr auto fileDescription = "raynodes save (.rn, .rnb)";
   static constexpr auto wikiLink = "https://github.com/gk646/raynodes/wiki";
   static constexpr auto github = "https://github.com/gk646/raynodes";
   static constexpr auto about = "Copyright #226# 2024 gk646. MIT License";
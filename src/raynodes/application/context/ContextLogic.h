@@ -31,12 +31,15 @@ struct Logic {
   Node* draggedPinNode = nullptr;                // Only assigned if "isMakingConnection" holds
   Component* draggedPinComponent = nullptr;      // NULL when node-to-node
   Pin* draggedPin = nullptr;                     // Start pin - Always valid if "isMakingConnection" holds
+  Node* focusNode = nullptr;                     // Node of the component gaining or losing focus - owns text actions
   Vector2 dragStart = {};                        // Anchor point for screen panning
   Vector2 selectPoint = {};                      // Anchor point for selection rect
   Vector2 mouse = {};                            // Mouse pos in screen space
   Vector2 worldMouse = {};                       // Mouse pos in world space
   Vector2 contextMenuPos = {};                   // Position of the context menu
   Vector2 draggedPinPos = {};                    // Position of the dragged pin
+  std::vector<Node*> mouseNodes;                 // Nodes close to the mouse - refreshed each tick
+  std::vector<Node*> queryNodes;                 // Scratch buffer for grid queries
   bool isSelecting = false;                      // Is user currently selecting
   bool isMakingConnection = false;               // Is user trying to connect pins
   bool isDraggingScreen = false;                 // Is user currently dragging the screen
@@ -51,6 +54,10 @@ struct Logic {
     draggedPinPos = {x, y};
     isMakingConnection = true;
   }
+  // Only these nodes can be hovered or have a pin clicked this tick
+  [[nodiscard]] bool isNearMouse(const Node& n) const {
+    return std::ranges::find(mouseNodes, &n) != mouseNodes.end();
+  }
   void handleDroppedPin(EditorContext& ec);
   void registerNodeContextActions(EditorContext& ec);
 };
@@ -22,15 +22,50 @@
 #define RAYNODES_SRC_APPLICATION_CONTEXT_CONTEXTPERSIST_H_
 
 struct EXPORT Persist {
+  static constexpr double LOAD_BUDGET = 0.008;  // Seconds per tick spent creating nodes of an async import
+  static constexpr std::chrono::milliseconds JOURNAL_FLUSH_INTERVAL{500};  // At most this much work is lost on a crash
+
   std::string openedFilePath;  // This is a string cause it can be reassigned often
   const char* fileName = nullptr;
+  std::future<ProjectSnapshot*> pendingSave;  // Background write of the last save - deleted on the main thread
+  ProjectLoad* pendingLoad = nullptr;         // Async import that is created over multiple ticks
+  std::string journalPath;                    // Journal of the opened project - empty if none is written
+  FILE* journal = nullptr;                    // Appended on each action - flushed in intervals
+  std::chrono::steady_clock::time_point journalFlushed;
+  long journalSaved = 0;  // Journal bytes contained in the pending save - dropped once it's written
+  bool journalDirty = false;
+  bool useJournal = false;  // Only the windowed editor journals - headless loads leave the journal alone
 
   bool loadUserFiles(EditorContext& ec);
-  bool importProject(EditorContext& ec);
+  // Async imports read the file on a worker thread and create the nodes over the next ticks
+  bool importProject(EditorContext& ec, bool async = false);
+  // Snapshots the project and writes it on a background thread - the title updates once it's written
   bool saveProject(EditorContext& ec, bool saveAsMode = false);
+  // Finishes a completed background save and continues an async import - called each tick
+  void update(EditorContext& ec);
+  // Stops an async import - the already loaded part stays
+  void cancelLoad();
+  [[nodiscard]] bool isLoading() const { return pendingLoad != nullptr; }
+  // Progress of an async import from 0 to 1
+  [[nodiscard]] float getLoadProgress() const;
+  // Blocks until the background save is written - returns if it succeeded
+  bool waitForSave(EditorContext& ec);
+  // Appends the changes of an added, undone or redone action to the journal
+  void journalAction(EditorContext& ec, const Action& action, bool undone);
+  // Writes the buffered journal records to disk
+  void flushJournal();
+  // Closes the journal but keeps the file - it's replayed when the project is opened again
+  void closeJournal();
+  // Closes and removes the journal - its changes were saved or discarded
+  void discardJournal();
   bool saveUserTemplates(EditorContext& ec);
   // Imports only the nodes from another project and calls func for each
   bool importNodesFromProject(EditorContext& ec);
+
+ private:
+  void finishLoad(EditorContext& ec);
+  void openJournal(EditorContext& ec, bool replay);
+  void compactJournal();
 };
 
 #endif  //RAYNODES_SRC_APPLICATION_CONTEXT_CONTEXTPERSIST_H_
\ No newline at end of file
@@ -21,12 +21,14 @@
 #ifndef CONTEXTPLUGIN_H
 #define CONTEXTPLUGIN_H
 
-struct Plugin {
+struct EXPORT Plugin {
   static constexpr auto* PLUGIN_PATH = "plugins/";
 
   std::vector<PluginContainer> plugins;
 
+  // Loads from the plugin folder next to the executable
   bool loadPlugins(EditorContext& ec);
+  bool loadPlugins(EditorContext& ec, const char* directory);
   void sortPlugins();
 };
 #endif  //CONTEXTPLUGIN_H
\ No newline at end of file
@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #include <ranges>
+#include <unordered_set>
 #include <tinyfiledialogs.h>
 
 #include "application/EditorContext.h"
@@ -38,7 +39,7 @@ struct ConnectionHelper {
     for (const auto entry : mapping) {
       if (entry.original == id) return entry.copied;
     }
-    return NodeID(UINT16_MAX);
+    return NodeID(UINT32_MAX);
   }
   void add(const NodeID original, const NodeID copied) {
     if (size < LIMIT) { mapping[size++] = {original, copied}; }
@@ -101,7 +102,7 @@ struct ConnectionHelper {
           const auto conn = in.connection;
           if (conn != nullptr) {
             const auto newFrom = getOriginalID(conn->fromNode.uID);
-            if (newFrom != UINT16_MAX) {
+            if (newFrom != UINT32_MAX) {
               const auto newID = getOriginalID(node->uID);
               addConnection(ec, newID, conn, newFrom);
             }
@@ -115,6 +116,179 @@ struct ConnectionHelper {
 
 static ConnectionHelper CONNECTION_HELPER;
 
+namespace {
+// Iterative Tarjan - long gate chains would overflow the stack when recursing
+// Appends the strongly connected components in reverse topological order (sinks first)
+void CollectComponents(const std::vector<int>& offsets, const std::vector<int>& edges, std::vector<int>& out) {
+  const int size = static_cast<int>(offsets.size()) - 1;
+  std::vector<int> index(size, -1);
+  std::vector<int> low(size, 0);
+  std::vector<bool> onStack(size, false);
+  std::vector<int> stack;
+  std::vector<Int2> callStack;  // x = node, y = next edge
+  stack.reserve(size);
+  int counter = 0;
+
+  auto visit = [&](const int n) {
+    index[n] = low[n] = counter++;
+    stack.push_back(n);
+    onStack[n] = true;
+    callStack.push_back({n, offsets[n]});
+  };
+
+  for (int root = 0; root < size; ++root) {
+    if (index[root] != -1) continue;
+    visit(root);
+
+    while (!callStack.empty()) {
+      const int n = callStack.back().x;
+      if (callStack.back().y < offsets[n + 1]) {
+        const int next = edges[callStack.back().y++];
+        if (index[next] == -1) visit(next);
+        else if (onStack[next]) low[n] = std::min(low[n], index[next]);
+        continue;
+      }
+
+      callStack.pop_back();
+      if (!callStack.empty()) {
+        const int parent = callStack.back().x;
+        low[parent] = std::min(low[parent], low[n]);
+      }
+
+      if (low[n] == index[n]) {
+        int member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          onStack[member] = false;
+          out.push_back(member);
+        } while (member != n);
+      }
+    }
+  }
+}
+// Actions can change component state without going through the pins
+void MarkAllDirty(const std::vector<Node*>& nodes) {
+  for (const auto n : nodes) {
+    for (const auto c : n->components) {
+      c->isDirty = true;
+    }
+  }
+}
+void LinkConnection(auto& nodeConnections, Connection* conn) {
+  nodeConnections[&conn->fromNode].push_back(conn);
+  if (&conn->toNode != &conn->fromNode) nodeConnections[&conn->toNode].push_back(conn);
+}
+void UnlinkConnection(auto& nodeConnections, const Node* node, const Connection* conn) {
+  const auto it = nodeConnections.find(node);
+  if (it == nodeConnections.end()) [[unlikely]] { return; }
+  auto& list = it->second;
+  for (auto& c : list) {
+    if (c == conn) {
+      c = list.back();
+      list.pop_back();
+      break;
+    }
+  }
+  if (list.empty()) nodeConnections.erase(it);
+}
+// Copied nodes must not outlive the action that owns them
+void DeleteAction(std::vector<Node*>& copiedNodes, Action* action) {
+  const std::vector<Node*>* owned = nullptr;
+  if (action->type == DELETE_NODE) {
+    const auto* deleteAction = static_cast<NodeDeleteAction*>(action);
+    if (deleteAction->ownsNodes()) owned = &deleteAction->deletedNodes;
+  } else if (action->type == CREATE_NODE) {
+    const auto* createAction = static_cast<NodeCreateAction*>(action);
+    if (createAction->ownsNodes()) owned = &createAction->createdNodes;
+  }
+  if (owned != nullptr) {
+    std::erase_if(copiedNodes, [owned](const Node* n) { return std::ranges::find(*owned, n) != owned->end(); });
+  }
+  delete action;
+}
+// Nodes that older actions or the clipboard point to - deletions of them can't be compacted
+struct HistoryReferences {
+  std::unordered_set<const Node*> nodes;
+  std::unordered_set<NodeID> textNodes;
+  bool unknownText = false;  // Text edit without a node - could point into any node
+
+  void add(const std::vector<Node*>& others) { nodes.insert(others.begin(), others.end()); }
+  void add(const std::vector<Connection*>& connections) {
+    for (const auto conn : connections) {
+      nodes.insert(&conn->fromNode);
+      nodes.insert(&conn->toNode);
+    }
+  }
+  void add(const Action& action) {
+    switch (action.type) {
+      case TEXT_EDIT: {
+        const auto id = static_cast<const TextAction&>(action).node;
+        if (id == UINT32_MAX) unknownText = true;
+        else textNodes.insert(id);
+        break;
+      }
+      case DELETE_NODE:
+        add(static_cast<const NodeDeleteAction&>(action).deletedNodes);
+        add(static_cast<const NodeDeleteAction&>(action).deletedConnections);
+        break;
+      case CREATE_NODE:
+        add(static_cast<const NodeCreateAction&>(action).createdNodes);
+        add(static_cast<const NodeCreateAction&>(action).createdConnection);
+        break;
+      case CONNECTION_CREATED:
+        add(static_cast<const ConnectionCreateAction&>(action).createdConnections);
+        break;
+      case CONNECTION_DELETED:
+        add(static_cast<const ConnectionDeleteAction&>(action).deletedConnections);
+        break;
+      case NEW_CANVAS_ACTION:
+      case MOVE_NODE:  // Uses ids
+        break;
+    }
+  }
+  [[nodiscard]] bool contains(const NodeDeleteAction& action) const {
+    if (unknownText) return true;
+    return std::ranges::any_of(action.deletedNodes,
+                               [this](const Node* n) { return nodes.contains(n) || textNodes.contains(n->uID); });
+  }
+};
+// Compacts the oldest deletions first, then drops the oldest actions until the history fits
+void LimitHistory(Core& core) {
+  auto& queue = core.actionQueue;
+
+  // Deletions before historyChecked were already compacted or are still referenced
+  // The current action is likely undone next
+  const int end = core.currentActionIndex;
+  if (core.historyBytes > core.historyBudget && core.historyChecked < end) {
+    HistoryReferences references;
+    references.add(core.copiedNodes);
+    int i = 0;
+    for (; i < end && core.historyBytes > core.historyBudget; ++i) {
+      auto* action = queue[i];
+      if (i >= core.historyChecked && action->type == DELETE_NODE) {
+        auto* deleteAction = static_cast<NodeDeleteAction*>(action);
+        if (!deleteAction->isCompact() && !references.contains(*deleteAction)) {
+          core.historyBytes -= deleteAction->getMemory();
+          deleteAction->compact();
+          core.historyBytes += deleteAction->getMemory();
+        }
+      }
+      references.add(*action);
+    }
+    core.historyChecked = std::max(core.historyChecked, i);
+  }
+
+  while (queue.size() > 2 && (core.historyBytes > core.historyBudget || queue.size() > Core::MAX_ACTIONS)) {
+    core.historyBytes -= queue.front()->getMemory();
+    DeleteAction(core.copiedNodes, queue.front());
+    queue.pop_front();
+    --core.currentActionIndex;
+    core.historyChecked = std::max(core.historyChecked - 1, 1);
+  }
+}
+}  // namespace
+
 bool Core::loadCore(EditorContext& ec) {
   hasUnsavedChanges = true;                    // Set flag to avoid unnecessary SetTitle
   addEditorAction(ec, new NewCanvasAction());  // Add first dummy action
@@ -125,7 +299,7 @@ bool Core::loadCore(EditorContext& ec) {
   nodeMap.reserve(200);
   nodes.reserve(200);
   copiedNodes.reserve(200);
-  connections.reserve(MAX_ACTIONS + 1);
+  connections.reserve(200);
   nodeGroups.reserve(5);
   return true;
 }
@@ -140,6 +314,8 @@ void Core::resetEditor(EditorContext& ec) {
   }
 
   actionQueue.clear();
+  historyBytes = 0;
+  historyChecked = 1;
 
   addEditorAction(ec, new NewCanvasAction());
 
@@ -150,6 +326,8 @@ void Core::resetEditor(EditorContext& ec) {
     delete n;
   }
   nodes.clear();
+  grid.clear();
+  nextZIndex = 0;
 
   copiedNodes.clear();
 
@@ -157,16 +335,24 @@ void Core::resetEditor(EditorContext& ec) {
     delete conn;
   }
   connections.clear();
+  connectionSlots.clear();
+  freeSlots.clear();
+  nodeConnections.clear();
+  updateOrder.clear();
+  ObjectPool::Release();  // Everything from the old project is gone
+  isOrderDirty = true;
+  simulationTick = 0;
+  tickAccumulator = 0.0F;
   UID = static_cast<NodeID>(0);
 
   hasUnsavedChanges = false;
 }
 
-Node* Core::createAddNode(EditorContext& ec, const char* name, const Vector2 worldPos, uint16_t hint) {
+Node* Core::createAddNode(EditorContext& ec, const char* name, const Vector2 worldPos, uint32_t hint) {
   if (name == nullptr) return nullptr;
 
   //Use the hint when provided
-  const auto nodeID = hint == UINT16_MAX ? getID() : static_cast<NodeID>(hint);
+  const auto nodeID = hint == UINT32_MAX ? getID() : static_cast<NodeID>(hint);
 
   // Calls event function internally
   Node* newNode = ec.templates.createNode(ec, name, {worldPos.x, worldPos.y}, nodeID);
@@ -181,6 +367,9 @@ void Core::insertNode(EditorContext& ec, Node& node) {
   if (nodeMap.contains(node.uID)) return;
   nodes.push_back(&node);
   nodeMap.insert({node.uID, &node});
+  node.zIndex = nextZIndex++;
+  grid.insert(node);
+  isOrderDirty = true;
 
   for (auto* c : node.components) {
     c->onAddedToScreen(ec, node);
@@ -195,12 +384,183 @@ void Core::removeNode(EditorContext& ec, const NodeID id) {
   if (node->isInGroup) [[unlikely]] { NodeGroup::InvokeDelete(ec, *node); }
   nodeMap.erase(id);
   std::erase(nodes, node);
+  grid.remove(*node);
+  isOrderDirty = true;
 
   for (const auto c : node->components) {
     c->onRemovedFromScreen(ec, *node);
   }
 }
 
+void Core::removeNodes(EditorContext& ec, const std::span<Node* const> targets) {
+  std::unordered_set<const Node*> removed;
+  removed.reserve(targets.size());
+  for (const auto node : targets) {
+    if (!nodeMap.erase(node->uID)) continue;
+    removed.insert(node);
+
+    if (node->isInGroup) [[unlikely]] { NodeGroup::InvokeDelete(ec, *node); }
+    grid.remove(*node);
+    for (const auto c : node->components) {
+      c->onRemovedFromScreen(ec, *node);
+    }
+  }
+  if (removed.empty()) return;
+  std::erase_if(nodes, [&removed](const Node* n) { return removed.contains(n); });
+  isOrderDirty = true;
+}
+
+void Core::buildUpdateOrder() {
+  isOrderDirty = false;
+  updateOrder.clear();
+  const int size = static_cast<int>(nodes.size());
+  if (size == 0) return;
+
+  std::unordered_map<const Node*, int> indices;
+  indices.reserve(size);
+  for (int i = 0; i < size; ++i) {
+    indices.insert({nodes[i], i});
+  }
+
+  // Flat adjacency - offsets[i] to offsets[i + 1] are the edges of node i
+  std::vector<Int2> pairs;
+  pairs.reserve(connections.size());
+  for (const auto* conn : connections) {
+    const auto from = indices.find(&conn->fromNode);
+    const auto to = indices.find(&conn->toNode);
+    if (from == indices.end() || to == indices.end()) [[unlikely]] { continue; }
+    pairs.push_back({from->second, to->second});
+  }
+
+  std::vector<int> offsets(size + 1, 0);
+  for (const auto [from, to] : pairs) {
+    ++offsets[from + 1];
+  }
+  for (int i = 0; i < size; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  std::vector<int> edges(pairs.size());
+  std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+  for (const auto [from, to] : pairs) {
+    edges[fill[from]++] = to;
+  }
+
+  std::vector<int> order;
+  order.reserve(size);
+  CollectComponents(offsets, edges, order);
+
+  // Reversed: sources first and unconnected nodes from front to back
+  updateOrder.reserve(size);
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    updateOrder.push_back(nodes[*it]);
+  }
+}
+
+void Core::removeConnection(Connection* conn) {
+  conn->close();
+  if (conn->slot == UINT32_MAX) [[unlikely]] { return; }
+
+  // Swap with the last connection - the freed slot gets a new generation so old handles turn invalid
+  auto& slot = connectionSlots[conn->slot];
+  Connection* last = connections.back();
+  connections[slot.index] = last;
+  connectionSlots[last->slot].index = slot.index;
+  connections.pop_back();
+
+  slot.index = UINT32_MAX;
+  ++slot.generation;
+  freeSlots.push_back(conn->slot);
+  conn->slot = UINT32_MAX;
+
+  UnlinkConnection(nodeConnections, &conn->fromNode, conn);
+  UnlinkConnection(nodeConnections, &conn->toNode, conn);
+  isOrderDirty = true;
+}
+
+void Core::addConnection(Connection* conn) {
+  conn->open();
+  if (conn->slot != UINT32_MAX) [[unlikely]] { return; }
+
+  if (freeSlots.empty()) {
+    conn->slot = static_cast<uint32_t>(connectionSlots.size());
+    connectionSlots.push_back({0, 0});
+  } else {
+    conn->slot = freeSlots.back();
+    freeSlots.pop_back();
+  }
+  connectionSlots[conn->slot].index = static_cast<uint32_t>(connections.size());
+  connections.push_back(conn);
+
+  LinkConnection(nodeConnections, conn);
+  isOrderDirty = true;
+}
+
+void Core::removeConnectionsFromNodes(const std::span<Node* const> targets, std::vector<Connection*>& collector) {
+  for (const auto node : targets) {
+    const auto it = nodeConnections.find(node);
+    if (it == nodeConnections.end()) continue;
+    // Copy - removing unlinks from this list
+    const auto list = it->second;
+    for (const auto conn : list) {
+      removeConnection(conn);
+      collector.push_back(conn);
+    }
+  }
+}
+
+const std::vector<Connection*>& Core::getConnections(const Node& node) const {
+  static const std::vector<Connection*> EMPTY;
+  const auto it = nodeConnections.find(&node);
+  return it == nodeConnections.end() ? EMPTY : it->second;
+}
+
+int Core::advanceTime(const float frameTime) {
+  tickAccumulator += std::min(frameTime, MAX_FRAME_TIME);
+  const float tickTime = 1.0F / tickRate;
+  const int ticks = static_cast<int>(tickAccumulator / tickTime);
+  tickAccumulator -= static_cast<float>(ticks) * tickTime;
+  return ticks;
+}
+
+int Core::updateNodes(EditorContext& ec, const float frameTime) {
+  const int ticks = advanceTime(frameTime);
+
+  stepMillis = ticks > 0 ? 1000.0F / tickRate : 0.0F;
+
+  //Input in reverse draw order - the topmost node under the mouse takes the click
+  auto& mouseNodes = ec.logic.mouseNodes;
+  std::ranges::sort(mouseNodes, [](const Node* n1, const Node* n2) { return n1->zIndex > n2->zIndex; });
+  for (auto* n : mouseNodes) {
+    Node::Update(ec, *n, false);
+  }
+  for (auto* n : nodes) {
+    if (!ec.logic.isNearMouse(*n)) Node::Update(ec, *n, false);
+  }
+
+  //Dependency order so values propagate through a whole chain within one tick
+  if (ticks > 0) {
+    for (auto* n : getUpdateOrder()) {
+      Node::Evaluate(ec, *n);  // Grouped nodes too - their group only handles input
+    }
+    ++simulationTick;
+  }
+
+  //Catch up on the remaining ticks without redrawing
+  for (int i = 1; i < ticks; ++i) {
+    simulateTick(ec);
+  }
+  return ticks;
+}
+
+void Core::simulateTick(EditorContext& ec) {
+  stepMillis = 1000.0F / tickRate;
+  for (auto* n : getUpdateOrder()) {
+    Node::Evaluate(ec, *n);
+  }
+  ++simulationTick;
+}
+
 void Core::paste(EditorContext& ec) const {
   if (copiedNodes.empty()) return;
   const Vector2 delta = {ec.logic.worldMouse.x - copiedNodes[0]->x, ec.logic.worldMouse.y - copiedNodes[0]->y};
@@ -245,10 +605,10 @@ void Core::erase(EditorContext& ec) {
 void Core::open(EditorContext& ec) {
   if (ec.core.hasUnsavedChanges) ec.ui.showUnsavedChanges = true;
   else {
-    auto* res = tinyfd_openFileDialog("Open File", nullptr, 1, Info::fileFilter, Info::fileDescription, 0);
+    auto* res = tinyfd_openFileDialog("Open File", nullptr, 2, Info::fileFilter, Info::fileDescription, 0);
     if (res != nullptr) {
       ec.persist.openedFilePath = res;
-      ec.persist.importProject(ec);
+      ec.persist.importProject(ec, true);
       ec.input.consumeKeyboard();
     }
   }
@@ -261,6 +621,9 @@ void Core::selectAll(EditorContext& /**/) {
 void Core::newFile(EditorContext& ec) {
   if (ec.core.hasUnsavedChanges) ec.ui.showUnsavedChanges = true;
   else {
+    ec.persist.waitForSave(ec);  // The snapshot nodes are returned to the pool reset below
+    ec.persist.cancelLoad();
+    ec.persist.discardJournal();
     ec.core.resetEditor(ec);
     ec.persist.openedFilePath.clear();
     ec.string.updateWindowTitle(ec);
@@ -276,6 +639,13 @@ void Core::copy(EditorContext& /**/) {
 void Core::addEditorAction(EditorContext& ec, Action* action) {
   if (!action) return;
 
+  if (action->type == TEXT_EDIT) {
+    auto* textAction = static_cast<TextAction*>(action);
+    if (ec.logic.focusNode != nullptr) textAction->node = ec.logic.focusNode->uID;
+    textAction->compact();
+  }
+  ec.persist.journalAction(ec, *action, false);
+
   // We never unset it even if the user undoes the action - cause its straightforward
   if (hasUnsavedChanges == false) {
     hasUnsavedChanges = true;
@@ -284,32 +654,40 @@ void Core::addEditorAction(EditorContext& ec, Action* action) {
 
   // If we're not at the end, remove all forward actions
   while (currentActionIndex < static_cast<int>(actionQueue.size()) - 1) {
-    delete actionQueue.back();  //Delete ptr
+    historyBytes -= actionQueue.back()->getMemory();
+    DeleteAction(copiedNodes, actionQueue.back());
     actionQueue.pop_back();
   }
 
   actionQueue.push_back(action);
+  historyBytes += action->getMemory();
   currentActionIndex = static_cast<int>(actionQueue.size()) - 1;  // Move to the new action
 
-  // Limit the queue size
-  if (actionQueue.size() > MAX_ACTIONS) {
-    delete actionQueue.front();  //Delete ptr
-    actionQueue.pop_front();
-    --currentActionIndex;
-  }
+  LimitHistory(*this);
 }
 void Core::undo(EditorContext& ec) {
   hasUnsavedChanges = true;  // Just set the flag for safety
   if (currentActionIndex >= 1) {
     // Check there's an action to undo
-    actionQueue[currentActionIndex]->undo(ec);
+    auto* action = actionQueue[currentActionIndex];
+    historyBytes -= action->getMemory();
+    action->undo(ec);
+    historyBytes += action->getMemory();
+    ec.persist.journalAction(ec, *action, true);
+    historyChecked = std::min(historyChecked, currentActionIndex);  // Restored deletions can be compacted again
     --currentActionIndex;  // Move back in the action queue
+    MarkAllDirty(nodes);
   }
 }
 void Core::redo(EditorContext& ec) {
   if (currentActionIndex < static_cast<int>(actionQueue.size()) - 1) {
     // Check there's an action to redo
     ++currentActionIndex;  // Move forward in the action queue
-    actionQueue[currentActionIndex]->redo(ec);
+    auto* action = actionQueue[currentActionIndex];
+    historyBytes -= action->getMemory();
+    action->redo(ec);
+    historyBytes += action->getMemory();
+    ec.persist.journalAction(ec, *action, false);
+    MarkAllDirty(nodes);
   }
 }
\ No newline at end of file
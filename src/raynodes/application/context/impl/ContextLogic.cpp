@@ -51,7 +51,11 @@ void FindDropPin(EditorContext& ec, Node& fromNode, Component* from, Pin* dragge
 
   const bool isOutputPin = draggedPin->direction == OUTPUT;
 
-  for (const auto n : ec.core.nodes) {
+  auto& candidates = ec.logic.queryNodes;
+  candidates.clear();
+  ec.core.grid.query(worldMouse, candidates);
+
+  for (const auto n : candidates) {
     //Extended Bound check on the node to skip iterating components
     const auto nodeBounds = n->getExtendedBounds(Pin::PIN_SIZE);
 
@@ -134,8 +138,6 @@ void Logic::registerNodeContextActions(EditorContext& ec) {
     ec.ui.nodeContextMenu.registerAction(
         "Remove connections",
         [](EditorContext& ec, Node& node) {
-          // Cant fully test for connections unless we iterate connections
-          // -> Outputs dont track connections!
           auto* action = new ConnectionDeleteAction(2);
           ec.core.removeConnectionsFromNode(node, action->deletedConnections);
           if (action->deletedConnections.empty()) delete action;
@@ -21,6 +21,8 @@
 #include "application/EditorContext.h"
 #include "application/elements/Action.h"
 
+#include <algorithm>
+#include <chrono>
 #include <ranges>
 #include <unordered_set>
 #include <cxutil/cxio.h>
@@ -74,125 +76,174 @@ static ComponentIndices compIndices{};
 
 //-----------PROJECT_FILES-----------//
 using namespace cxstructs;  // using the namespace here
+// Everything a save writes - taken on the main thread so the file is formatted and written on the save thread
+// Created and deleted on the main thread - the nodes are pool allocated
+struct ProjectSnapshot {
+  struct GroupData {
+    Vector2 pos;
+    std::string name;
+    bool expanded;
+    std::vector<int> nodes;
+  };
+  std::string path;
+  bool isBinary = false;
+  std::vector<Node*> nodes;             // Clones owned by the snapshot
+  std::vector<NodeTemplate> templates;  // Templates of the saved nodes in registration order
+  std::vector<ConnectionData> connections;
+  std::vector<GroupData> groups;
+  Vector2 cameraTarget{};
+  float cameraZoom = 1.0F;
+  ComponentIndices indices{};  // Own instance - loading can use compIndices while this is saved
+  bool saved = false;          // Result of the save thread
+
+  ProjectSnapshot() = default;
+  ProjectSnapshot(const ProjectSnapshot&) = delete;
+  ProjectSnapshot& operator=(const ProjectSnapshot&) = delete;
+  ~ProjectSnapshot() {
+    for (const auto n : nodes) {
+      delete n;
+    }
+  }
+};
 namespace {
-bool IsValidConnection(int maxNodeID, int fromNode, int from, int out, int toNode, int to, int in) {
-  const bool correctNode = fromNode >= 0 && fromNode < maxNodeID && toNode >= 0 && toNode < maxNodeID;
-  const bool correctFromComponent = (from >= 0 && from < COMPS_PER_NODE) || from == -1;
-  const bool correctToComponent = (to >= 0 && to < COMPS_PER_NODE) || to == -1;
-  return correctNode && correctFromComponent && correctToComponent && out != -1 && in != -1;
-}
-Connection* CreateNewConnection(EditorContext& ec, int fromID, int fromI, int outI, int toID, int toI, int inI) {
-  const auto& nodeMap = ec.core.nodeMap;
-  // We use int8_t as size_type to save space
-  Node& fromNode = *nodeMap.at(static_cast<NodeID>(fromID));
+// Only copies - nothing the editor changes later is referenced except the template labels
+ProjectSnapshot* TakeSnapshot(EditorContext& ec, const std::string& path) {
+  const auto& core = ec.core;
+  auto* s = new ProjectSnapshot();
+  s->path = path;
+  s->isBinary = IsFileExtension(path.c_str(), Info::binaryFileEnding);
+  s->cameraTarget = ec.display.camera.target;
+  s->cameraZoom = ec.display.camera.zoom;
 
-  Component* from = nullptr;
-  OutputPin* out;
-  if (fromI != -1) {
-    from = fromNode.components[static_cast<int8_t>(fromI)];
-    out = &from->outputs[static_cast<int8_t>(outI)];
-  } else {
-    out = &fromNode.outputs[static_cast<int8_t>(outI)];
+  // Only save unique nodes
+  std::unordered_set<const char*, Fnv1aHash, StrEqual> uniqueNodes;
+  s->nodes.reserve(core.nodes.size());
+  for (const auto node : core.nodes) {
+    uniqueNodes.insert(node->name);
+    s->nodes.push_back(node->clone(node->uID));
+  }
+  for (const auto& nt : ec.templates.registeredNodes | std::views::values) {
+    if (uniqueNodes.contains(nt.nTemplate.label)) s->templates.push_back(nt.nTemplate);
+  }
+  for (const auto& nt : ec.templates.userDefinedNodes | std::views::values) {
+    if (uniqueNodes.contains(nt.nTemplate.label)) s->templates.push_back(nt.nTemplate);
   }
 
-  Node& toNode = *nodeMap.at(static_cast<NodeID>(toID));
-  Component* to = nullptr;
-  InputPin* in = nullptr;
-  if (toI != -1) {
-    to = toNode.components[static_cast<int8_t>(toI)];
-    in = &to->inputs[static_cast<int8_t>(inI)];
-  } else {
-    in = &toNode.nodeIn;
+  s->connections.reserve(core.connections.size());
+  for (const auto conn : core.connections) {
+    s->connections.push_back(conn->getData());
   }
 
-  const auto conn = new Connection(fromNode, from, *out, toNode, to, *in);
-  ec.core.addConnection(conn);
+  for (const auto& ng : core.nodeGroups) {
+    auto& group = s->groups.emplace_back(ng.pos, ng.name == nullptr ? "" : ng.name, ng.expanded);
+    for (const auto n : ng.nodes) {
+      group.nodes.push_back(static_cast<int>(n->uID));
+    }
+  }
+  return s;
+}
+bool IsValidConnection(const int maxNodeID, const ConnectionData& data) {
+  const auto& [fromNode, from, out, toNode, to, in] = data;
+  const bool correctNode = fromNode >= 0 && fromNode < maxNodeID && toNode >= 0 && toNode < maxNodeID;
+  const bool correctFromComponent = (from >= 0 && from < COMPS_PER_NODE) || from == -1;
+  const bool correctToComponent = (to >= 0 && to < COMPS_PER_NODE) || to == -1;
+  return correctNode && correctFromComponent && correctToComponent && out != -1 && in != -1;
+}
+// Returns nullptr if the pins don't exist
+Connection* CreateNewConnection(EditorContext& ec, const ConnectionData& data) {
+  const auto conn = Connection::Create(ec, data);
+  if (conn != nullptr) ec.core.addConnection(conn);
   return conn;
 }
-void SaveEditorData(FILE* file, EditorContext& ec) {
+void SaveConnectionData(FILE* file, const ConnectionData& data) {
+  //Output
+  io_save(file, data.fromNode);
+  io_save(file, data.from);
+  io_save(file, data.out);
+  //Input
+  io_save(file, data.toNode);
+  io_save(file, data.to);
+  io_save(file, data.in);
+}
+ConnectionData LoadConnectionData(ByteReader& reader) {
+  ConnectionData data{};
+  //Output
+  io_load(reader, data.fromNode);
+  io_load(reader, data.from);
+  io_load(reader, data.out);
+  //Input
+  io_load(reader, data.toNode);
+  io_load(reader, data.to);
+  io_load(reader, data.in);
+  return data;
+}
+// The narrow format keeps the project readable by the default RnImport (16 bit ids and counts, 8 bit template ids)
+int GetFileFormat(const ProjectSnapshot& s) {
+  if (s.nodes.size() > UINT16_MAX || s.connections.size() > UINT16_MAX) return Info::fileFormatWide;
+  // UINT16_MAX is INVALID_NODE of the narrow import - the highest usable id is one below
+  for (const auto n : s.nodes) {
+    if (n->uID > UINT16_MAX - 1) return Info::fileFormatWide;
+  }
+  return s.templates.size() > UINT8_MAX + 1 ? Info::fileFormatWide : Info::fileFormatNarrow;
+}
+void SaveEditorData(FILE* file, const ProjectSnapshot& s) {
   io_save_section(file, "EditorData");
-  io_save(file, static_cast<int>(ec.core.nodes.size()));        // Total nodes
-  io_save(file, static_cast<int>(ec.core.connections.size()));  // Total connections
-  io_save(file, ec.display.camera.target.x);
-  io_save(file, ec.display.camera.target.y);
-  io_save(file, ec.display.camera.zoom);
+  io_save(file, static_cast<int>(s.nodes.size()));        // Total nodes
+  io_save(file, static_cast<int>(s.connections.size()));  // Total connections
+  io_save(file, s.cameraTarget.x);
+  io_save(file, s.cameraTarget.y);
+  io_save(file, s.cameraZoom);
+  // Only wide files carry the format - narrow files stay readable by older versions
+  const int format = GetFileFormat(s);
+  if (format != Info::fileFormatNarrow) io_save(file, format);
   io_save_newline(file);
 }
-void SaveTemplates(FILE* file, EditorContext& ec) {
+void SaveTemplates(FILE* file, ProjectSnapshot& s) {
   io_save_section(file, "Templates");
-
-  // Only save unique nodes
-  std::unordered_set<const char*, Fnv1aHash, StrEqual> uniqueNodes;
-  for (const auto node : ec.core.nodes) {
-    uniqueNodes.insert(node->name);
-  }
-
-  io_save(file, static_cast<int>(uniqueNodes.size()));
+  io_save(file, static_cast<int>(s.templates.size()));
   io_save_newline(file);
-
-  // Save func
-  constexpr auto saveTemplate = [](FILE* file, const NodeInfo& nt) {
-    io_save(file, compIndices.add(nt.nTemplate.label));  // The arbitrary id of the template
-    io_save(file, nt.nTemplate.label);                   // The node name
-    for (const auto& [label, component] : nt.nTemplate.components) {
+  for (const auto& nt : s.templates) {
+    io_save(file, s.indices.add(nt.label));  // The arbitrary id of the template
+    io_save(file, nt.label);                 // The node name
+    for (const auto& [label, component] : nt.components) {
       io_save(file, label == nullptr ? "" : label);
     }
-    const auto [r, g, b, a] = nt.nTemplate.color;
+    const auto [r, g, b, a] = nt.color;
     io_save(file, ColorToInt({r, g, b, a}));
     io_save_newline(file);
-  };
-
-  for (const auto& nt : ec.templates.registeredNodes | std::views::values) {
-    if (!uniqueNodes.contains(nt.nTemplate.label)) continue;
-    saveTemplate(file, nt);
-  }
-  for (const auto& nt : ec.templates.userDefinedNodes | std::views::values) {
-    if (!uniqueNodes.contains(nt.nTemplate.label)) continue;
-    saveTemplate(file, nt);
   }
 }
-int SaveNodes(FILE* file, EditorContext& ec) {
+int SaveNodes(FILE* file, const ProjectSnapshot& s) {
   io_save_section(file, "Nodes");
   int count = 0;
-  for (const auto n : ec.core.nodes) {
-    io_save(file, compIndices.get(n->name));
+  for (const auto n : s.nodes) {
+    io_save(file, s.indices.get(n->name));
     Node::SaveState(file, *n);
     io_save_newline(file);
     count++;
   }
   return count;
 }
-int SaveConnections(FILE* file, EditorContext& ec) {
+int SaveConnections(FILE* file, const ProjectSnapshot& s) {
   io_save_section(file, "Connections");
   int count = 0;
-  const auto& connections = ec.core.connections;
-  for (const auto conn : connections) {
-    Node& fromNode = conn->fromNode;  //Output Node
-    const Component* from = conn->from;
-    io_save(file, fromNode.uID);
-    io_save(file, fromNode.getComponentIndex(from));
-    io_save(file, fromNode.getPinIndex(from, conn->out));
-
-    Node& toNode = conn->toNode;  //Input Node
-    const Component* to = conn->to;
-    io_save(file, toNode.uID);
-    io_save(file, toNode.getComponentIndex(to));
-    io_save(file, toNode.getPinIndex(to, conn->in));
+  for (const auto& data : s.connections) {
+    SaveConnectionData(file, data);
     //End with newline
     io_save_newline(file);
     count++;
   }
   return count;
 }
-void SaveGroups(FILE* file, EditorContext& ec) {
+void SaveGroups(FILE* file, const ProjectSnapshot& s) {
   io_save_section(file, "Groups");
-  for (const auto& ng : ec.core.nodeGroups) {
+  for (const auto& ng : s.groups) {
     io_save(file, static_cast<int>(ng.pos.x));
     io_save(file, static_cast<int>(ng.pos.y));
-    io_save(file, ng.name);
+    io_save(file, ng.name.c_str());
     io_save(file, ng.expanded);
-    for (const auto n : ng.nodes) {
-      io_save(file, n->uID);
+    for (const auto id : ng.nodes) {
+      io_save(file, id);
     }
     io_save_newline(file);
   }
@@ -200,111 +251,440 @@ void SaveGroups(FILE* file, EditorContext& ec) {
 void SaveComments(FILE* file, EditorContext& ec) {
   io_save_section(file, "Comments");
 }
-void LoadEditorData(FILE* file, EditorContext& ec) {
-  io_load_newline(file, true);   //Skip the Editor section
-  io_load_skip_separator(file);  // Node count
-  io_load_skip_separator(file);  // Connection count
-  io_load(file, ec.display.camera.target.x);
-  io_load(file, ec.display.camera.target.y);
-  io_load(file, ec.display.camera.zoom);
-  io_load_newline(file);
-}
-void LoadTemplates(FILE* file) {
-  io_load_newline(file, false);
+void LoadEditorData(ByteReader& reader, EditorContext& ec, int& nodes, int& connections) {
+  io_load_newline(reader, true);  //Skip the Editor section
+  io_load(reader, nodes);
+  io_load(reader, connections);
+  io_load(reader, ec.display.camera.target.x);
+  io_load(reader, ec.display.camera.target.y);
+  io_load(reader, ec.display.camera.zoom);
+  int format = Info::fileFormatNarrow;
+  if (!io_load_is_newline(reader)) io_load(reader, format);
+  if (format > Info::fileFormatWide) fprintf(stderr, "Project was saved with a newer format (%d)\n", format);
+  io_load_newline(reader);
+}
+void LoadTemplates(ByteReader& reader) {
+  io_load_newline(reader, false);
   int amount = 0;
-  io_load(file, amount);
-  io_load_newline(file, true);
+  io_load(reader, amount);
+  io_load_newline(reader, true);
   char buff[PLG_MAX_NAME_LEN];
   for (int i = 0; i < amount; ++i) {
     int index;
-    io_load(file, index);
-    io_load(file, buff, PLG_MAX_NAME_LEN);
+    io_load(reader, index);
+    io_load(reader, buff, PLG_MAX_NAME_LEN);
     compIndices.add(buff, index);
-    io_load_newline(file, true);
+    io_load_newline(reader, true);
   }
 }
-int LoadNodes(FILE* file, EditorContext& ec) {
-  int count = 0;
-  while (io_load_inside_section(file, "Nodes")) {
-    int index = -1;
-    io_load(file, index);
-    if (index == -1) {
-      io_load_newline(file, true);
-      continue;
-    }
-    int id;
-    io_load(file, id);
-    auto* nodeName = compIndices.getName(index);
-    const auto newNode = ec.core.createAddNode(ec, nodeName, {0, 0}, static_cast<uint16_t>(id));
-    if (!newNode) {
-      io_load_newline(file, true);
-      continue;
-    }
-    Node::LoadState(file, *newNode);
-    ec.core.UID = std::max(ec.core.UID, static_cast<NodeID>(newNode->uID + 1));
-    io_load_newline(file);
-    count++;
+// Loads a single node - returns false at the end of the section
+bool LoadNextNode(ByteReader& reader, EditorContext& ec) {
+  if (!io_load_inside_section(reader, "Nodes")) return false;
+  int index = -1;
+  io_load(reader, index);
+  if (index == -1) {
+    io_load_newline(reader, true);
+    return true;
   }
-  return count;
-}
-int LoadConnections(FILE* file, EditorContext& ec) {
-  int count = 0;
-  const int maxNodeID = ec.core.UID;
-  while (io_load_inside_section(file, "Connections")) {
-    int fromNode, from, out;
-    int toNode, to, in;
-    //Output
-    io_load(file, fromNode);
-    io_load(file, from);
-    io_load(file, out);
-    //Input
-    io_load(file, toNode);
-    io_load(file, to);
-    io_load(file, in);
-    if (IsValidConnection(maxNodeID, fromNode, from, out, toNode, to, in)) {
-      CreateNewConnection(ec, fromNode, from, out, toNode, to, in);
-    }
-    io_load_newline(file);
-    count++;
+  int id;
+  io_load(reader, id);
+  auto* nodeName = compIndices.getName(index);
+  const auto newNode = ec.core.createAddNode(ec, nodeName, {0, 0}, static_cast<uint32_t>(id));
+  if (!newNode) {
+    io_load_newline(reader, true);
+    return true;
   }
-  return count;
+  Node::LoadState(reader, *newNode);
+  ec.core.grid.update(*newNode);
+  ec.core.UID = std::max(ec.core.UID, static_cast<NodeID>(newNode->uID + 1));
+  io_load_newline(reader);
+  return true;
+}
+// Loads a single connection - returns false at the end of the section
+bool LoadNextConnection(ByteReader& reader, EditorContext& ec, const int maxNodeID) {
+  if (!io_load_inside_section(reader, "Connections")) return false;
+  const auto data = LoadConnectionData(reader);
+  if (IsValidConnection(maxNodeID, data)) CreateNewConnection(ec, data);
+  io_load_newline(reader);
+  return true;
 }
-void LoadGroups(FILE* file, EditorContext& ec) {
-  while (io_load_inside_section(file, "Groups")) {
+void LoadGroups(ByteReader& reader, EditorContext& ec) {
+  while (io_load_inside_section(reader, "Groups")) {
     int x, y;
     char buff[PLG_MAX_NAME_LEN];
     bool expanded;
-    io_load(file, x);
-    io_load(file, y);
-    io_load(file, buff, PLG_MAX_NAME_LEN);
-    io_load(file, expanded);
+    io_load(reader, x);
+    io_load(reader, y);
+    io_load(reader, buff, PLG_MAX_NAME_LEN);
+    io_load(reader, expanded);
     auto& ng = ec.core.nodeGroups.emplace_back(static_cast<float>(x), static_cast<float>(y), buff, expanded);
-    while (!io_load_is_newline(file)) {
+    while (!io_load_is_newline(reader)) {
       int id;
-      io_load(file, id);
+      io_load(reader, id);
       auto* node = ec.core.getNode(static_cast<NodeID>(id));
-      // To get the correct dimensions
+      // To get the correct dimensions - only possible with a window (headless runtime)
       if (node) {
-        Node::Draw(ec, *node);
-        Node::Update(ec, *node);
+        if (IsWindowReady()) {
+          Node::Draw(ec, *node);
+          Node::Update(ec, *node);
+        }
         ng.addNode(ec, *node);
       }
     }
-    io_load_newline(file, true);
+    io_load_newline(reader, true);
   }
 }
-void LoadComments(FILE* file, EditorContext& ec) {
-  io_load_newline(file, true);
+void LoadComments(ByteReader& reader, EditorContext& ec) {
+  io_load_newline(reader, true);
+}
+}  // namespace
+
+//-----------BINARY_PROJECT_FILES-----------//
+namespace {
+void SaveEditorData(BinaryWriter& w, const ProjectSnapshot& s) {
+  w.writeVarint(s.nodes.size());        // Total nodes
+  w.writeVarint(s.connections.size());  // Total connections
+  w.writeFloat(s.cameraTarget.x);
+  w.writeFloat(s.cameraTarget.y);
+  w.writeFloat(s.cameraZoom);
+}
+// Nodes reference their template by its index in this section
+void SaveTemplates(BinaryWriter& w, const ProjectSnapshot& s, std::unordered_map<std::string_view, uint32_t>& indices) {
+  for (const auto node : s.nodes) {
+    indices.insert({node->name, static_cast<uint32_t>(indices.size())});
+  }
+  std::vector<std::string_view> names(indices.size());
+  for (const auto& [name, index] : indices) {
+    names[index] = name;
+  }
+  w.writeVarint(names.size());
+  for (const auto name : names) {
+    w.writeString(std::string(name));
+  }
+}
+void SaveNodes(BinaryWriter& w, const ProjectSnapshot& s, const std::unordered_map<std::string_view, uint32_t>& indices) {
+  w.writeVarint(s.nodes.size());
+  // Nodes are length prefixed - unknown templates can be skipped when loading
+  BinaryWriter node{w.strings};
+  for (const auto n : s.nodes) {
+    w.writeVarint(indices.at(n->name));
+    node.clear();
+    Node::SaveState(node, *n);
+    w.writeBlob(node.data.data(), node.data.size());
+  }
+}
+void SaveConnections(BinaryWriter& w, const ProjectSnapshot& s) {
+  w.writeVarint(s.connections.size());
+  for (const auto& data : s.connections) {
+    data.save(w);
+  }
+}
+void SaveGroups(BinaryWriter& w, const ProjectSnapshot& s) {
+  w.writeVarint(s.groups.size());
+  for (const auto& ng : s.groups) {
+    w.writeFloat(ng.pos.x);
+    w.writeFloat(ng.pos.y);
+    w.writeString(ng.name);
+    w.writeBool(ng.expanded);
+    w.writeVarint(ng.nodes.size());
+    for (const auto id : ng.nodes) {
+      w.writeVarint(id);
+    }
+  }
+}
+bool SaveBinaryProject(const ProjectSnapshot& s) {
+  // Sections are written separately - the string table is only complete after all others
+  StringTable strings;
+  std::vector<BinaryWriter> sections(RNB_SECTION_COUNT, BinaryWriter{&strings});
+  std::unordered_map<std::string_view, uint32_t> templateIndices;
+  SaveEditorData(sections[RNB_EDITOR_DATA], s);
+  SaveTemplates(sections[RNB_TEMPLATES], s, templateIndices);
+  SaveNodes(sections[RNB_NODES], s, templateIndices);
+  SaveConnections(sections[RNB_CONNECTIONS], s);
+  SaveGroups(sections[RNB_GROUPS], s);
+
+  auto& stringSection = sections[RNB_STRINGS];
+  stringSection.writeVarint(strings.strings.size());
+  for (const auto& str : strings.strings) {
+    stringSection.writeBlob(str.data(), str.size());
+  }
+
+  BinaryWriter file;
+  file.writeBytes(RNB_MAGIC, sizeof(RNB_MAGIC));
+  file.writeByte(RNB_VERSION);
+  file.writeU32(RNB_SECTION_COUNT);
+  auto offset = static_cast<uint32_t>(RNB_HEADER_SIZE + RNB_SECTION_COUNT * RNB_SECTION_ENTRY_SIZE);
+  for (uint32_t i = 0; i < RNB_SECTION_COUNT; ++i) {
+    const auto size = static_cast<uint32_t>(sections[i].data.size());
+    file.writeU32(i);
+    file.writeU32(offset);
+    file.writeU32(size);
+    offset += size;
+  }
+  for (const auto& section : sections) {
+    file.writeBytes(section.data.data(), section.data.size());
+  }
+
+  FILE* out = fopen(s.path.c_str(), "wb");
+  if (out == nullptr) return false;
+  const auto written = fwrite(file.data.data(), 1, file.data.size(), out);
+  return fclose(out) == 0 && written == file.data.size();
+}
+
+// Sections and the string table of a binary project - points into the file data
+struct BinaryProject {
+  std::vector<std::string_view> strings;
+  BinaryReader sections[RNB_SECTION_COUNT]{};
+
+  BinaryProject() = default;
+  BinaryProject(const BinaryProject&) = delete;
+  BinaryProject& operator=(const BinaryProject&) = delete;
+
+  static bool IsBinary(const ByteReader& reader) {
+    const auto size = reader.end - reader.data.data();
+    return size >= RNB_HEADER_SIZE && std::memcmp(reader.data.data(), RNB_MAGIC, sizeof(RNB_MAGIC)) == 0;
+  }
+
+  bool open(const ByteReader& reader) {
+    const auto size = static_cast<size_t>(reader.end - reader.data.data());
+    BinaryReader header{reader.data.data(), size};
+    header.cursor += sizeof(RNB_MAGIC);
+    const auto version = header.readByte();
+    if (version > RNB_VERSION) {
+      fprintf(stderr, "Project was saved with a newer version (%d)\n", version);
+      return false;
+    }
+
+    const auto count = header.readU32();
+    for (uint32_t i = 0; i < count && !header.failed; ++i) {
+      const auto id = header.readU32();
+      const auto offset = header.readU32();
+      const auto length = header.readU32();
+      if (static_cast<size_t>(offset) + length > size) return false;
+      if (id < RNB_SECTION_COUNT) sections[id] = BinaryReader{reader.data.data() + offset, length, &strings};
+    }
+
+    auto& stringSection = sections[RNB_STRINGS];
+    const auto stringCount = stringSection.readVarint();
+    for (uint64_t i = 0; i < stringCount && !stringSection.failed; ++i) {
+      const auto str = stringSection.readBlob();
+      strings.emplace_back(reinterpret_cast<const char*>(str.cursor), str.remaining());
+    }
+    return !header.failed && !stringSection.failed;
+  }
+  [[nodiscard]] bool failed() const {
+    return std::ranges::any_of(sections, [](const BinaryReader& r) { return r.failed; });
+  }
+};
+
+void LoadEditorData(BinaryReader r, EditorContext& ec, uint64_t& nodes, uint64_t& connections) {
+  nodes = r.readVarint();
+  connections = r.readVarint();
+  ec.display.camera.target.x = r.readFloat();
+  ec.display.camera.target.y = r.readFloat();
+  ec.display.camera.zoom = r.readFloat();
+}
+std::vector<std::string> LoadTemplates(BinaryReader& r) {
+  std::vector<std::string> names(r.readVarint());
+  for (auto& name : names) {
+    name = r.readString();
+  }
+  return names;
+}
+// Node ids are offset by startID - created nodes are appended to created if given
+void LoadNode(BinaryReader& r, EditorContext& ec, const std::vector<std::string>& templates, const int startID,
+              std::vector<Node*>* created) {
+  const auto index = r.readVarint();
+  BinaryReader node = r.readBlob();
+  if (index >= templates.size()) return;
+  const auto id = static_cast<NodeID>(startID + node.readVarint());
+  const auto newNode = ec.core.createAddNode(ec, templates[index].c_str(), {0, 0}, id);
+  if (!newNode) return;
+  Node::LoadState(node, *newNode);
+  if (node.failed) fprintf(stderr, "Node %u has damaged component data\n", newNode->uID);
+  ec.core.grid.update(*newNode);
+  ec.core.UID = std::max(ec.core.UID, static_cast<NodeID>(newNode->uID + 1));
+  if (created) created->push_back(newNode);
+}
+void LoadNodes(BinaryReader& r, EditorContext& ec, const std::vector<std::string>& templates, const int startID,
+               std::vector<Node*>* created) {
+  const auto amount = r.readVarint();
+  for (uint64_t i = 0; i < amount && !r.failed; ++i) {
+    LoadNode(r, ec, templates, startID, created);
+  }
+}
+void LoadConnection(BinaryReader& r, EditorContext& ec, const int startID, const int maxNodeID,
+                    std::vector<Connection*>* created) {
+  ConnectionData data{};
+  data.load(r);
+  data.fromNode += startID;
+  data.toNode += startID;
+  if (!IsValidConnection(maxNodeID, data)) return;
+  auto* conn = CreateNewConnection(ec, data);
+  if (created && conn) created->push_back(conn);
+}
+void LoadConnections(BinaryReader& r, EditorContext& ec, const int startID, const int maxNodeID,
+                     std::vector<Connection*>* created) {
+  const auto amount = r.readVarint();
+  for (uint64_t i = 0; i < amount && !r.failed; ++i) {
+    LoadConnection(r, ec, startID, maxNodeID, created);
+  }
+}
+void LoadGroups(BinaryReader& r, EditorContext& ec, const int startID) {
+  const auto amount = r.readVarint();
+  for (uint64_t i = 0; i < amount && !r.failed; ++i) {
+    const float x = r.readFloat();
+    const float y = r.readFloat();
+    const std::string name{r.readString()};
+    const bool expanded = r.readBool();
+    auto& ng = ec.core.nodeGroups.emplace_back(x, y, name.c_str(), expanded);
+    const auto nodes = r.readVarint();
+    for (uint64_t j = 0; j < nodes && !r.failed; ++j) {
+      auto* node = ec.core.getNode(static_cast<NodeID>(startID + r.readVarint()));
+      // To get the correct dimensions - only possible with a window (headless runtime)
+      if (node) {
+        if (IsWindowReady()) {
+          Node::Draw(ec, *node);
+          Node::Update(ec, *node);
+        }
+        ng.addNode(ec, *node);
+      }
+    }
+  }
+}
+}  // namespace
+
+//-----------PROJECT_LOADING-----------//
+// An import that is spread over multiple ticks - the file is read on a worker thread
+// Nodes are created on the main thread as components load themselves into the live nodes
+struct ProjectLoad {
+  enum Phase : uint8_t { READING, NODES, CONNECTIONS, GROUPS, DONE };
+  std::string path;
+  ByteReader reader;
+  BinaryProject project;
+  std::vector<std::string> templates;  // Template names of binary projects
+  std::future<bool> reading;
+  bool isBinary = false;
+  Phase phase = READING;
+  uint64_t total = 0;      // Nodes and connections in the file
+  uint64_t loaded = 0;     // Nodes and connections loaded so far
+  uint64_t remaining = 0;  // Left in the current binary section
+  int maxNodeID = 0;
+
+  // Called on the worker thread
+  bool read() {
+    // Read the whole file at once - parsing from memory avoids a read call per byte
+    if (!reader.open(path.c_str())) {
+      fprintf(stderr, "Unable to open file %s\n", path.c_str());
+      return false;
+    }
+    // The format is detected from the file content
+    isBinary = BinaryProject::IsBinary(reader);
+    if (isBinary && !project.open(reader)) {
+      fprintf(stderr, "Invalid binary project %s\n", path.c_str());
+      return false;
+    }
+    return true;
+  }
+  [[nodiscard]] float getProgress() const {
+    if (phase == READING) return 0.0F;
+    return total == 0 ? 1.0F : std::min(1.0F, static_cast<float>(loaded) / static_cast<float>(total));
+  }
+};
+
+namespace {
+void StartLoad(ProjectLoad& load, EditorContext& ec) {
+  // Reset editor to initial state
+  ec.core.resetEditor(ec);
+  compIndices.reset();
+
+  if (load.isBinary) {
+    auto& sections = load.project.sections;
+    uint64_t nodes, connections;
+    LoadEditorData(sections[RNB_EDITOR_DATA], ec, nodes, connections);
+    load.total = nodes + connections;
+    load.templates = LoadTemplates(sections[RNB_TEMPLATES]);
+    load.remaining = sections[RNB_NODES].readVarint();
+  } else {
+    int nodes = 0, connections = 0;
+    LoadEditorData(load.reader, ec, nodes, connections);
+    load.total = static_cast<uint64_t>(std::max(nodes, 0)) + static_cast<uint64_t>(std::max(connections, 0));
+    LoadTemplates(load.reader);
+  }
+  load.phase = ProjectLoad::NODES;
+}
+// Loads nodes and connections until the budget (seconds) is used up - returns true when the project is loaded
+bool StepLoad(ProjectLoad& load, EditorContext& ec, const double budget) {
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  const auto inBudget = [&] {
+    return std::chrono::duration<double>(Clock::now() - start).count() < budget;
+  };
+  auto& sections = load.project.sections;
+
+  while (load.phase == ProjectLoad::NODES && inBudget()) {
+    bool hasNext;
+    if (load.isBinary) {
+      hasNext = load.remaining > 0 && !sections[RNB_NODES].failed;
+      if (hasNext) {
+        LoadNode(sections[RNB_NODES], ec, load.templates, 0, nullptr);
+        load.remaining--;
+      }
+    } else {
+      hasNext = LoadNextNode(load.reader, ec);
+    }
+    if (hasNext) {
+      load.loaded++;
+      continue;
+    }
+    // Connections are only valid between loaded nodes
+    load.maxNodeID = static_cast<int>(ec.core.UID);
+    if (load.isBinary) load.remaining = sections[RNB_CONNECTIONS].readVarint();
+    load.phase = ProjectLoad::CONNECTIONS;
+  }
+
+  while (load.phase == ProjectLoad::CONNECTIONS && inBudget()) {
+    bool hasNext;
+    if (load.isBinary) {
+      hasNext = load.remaining > 0 && !sections[RNB_CONNECTIONS].failed;
+      if (hasNext) {
+        LoadConnection(sections[RNB_CONNECTIONS], ec, 0, load.maxNodeID, nullptr);
+        load.remaining--;
+      }
+    } else {
+      hasNext = LoadNextConnection(load.reader, ec, load.maxNodeID);
+    }
+    if (hasNext) {
+      load.loaded++;
+      continue;
+    }
+    load.phase = ProjectLoad::GROUPS;
+  }
+
+  // Groups are few but measure their nodes - loaded at once
+  if (load.phase == ProjectLoad::GROUPS && inBudget()) {
+    if (load.isBinary) {
+      LoadGroups(sections[RNB_GROUPS], ec, 0);
+      if (load.project.failed()) fprintf(stderr, "Binary project %s is truncated\n", load.path.c_str());
+    } else {
+      LoadGroups(load.reader, ec);
+    }
+    load.phase = ProjectLoad::DONE;
+  }
+  return load.phase == ProjectLoad::DONE;
 }
 }  // namespace
 
 bool Persist::saveProject(EditorContext& ec, const bool saveAsMode) {
+  // A partially loaded project is never written
+  if (pendingLoad != nullptr) return false;
+
   // Strictly enforce this to limit saving -> Actions need to be accurate
   if (!ec.core.hasUnsavedChanges && !saveAsMode) return true;
 
   // If "SaveAs" we want to save with a new name - regardless of an existing one
   if (saveAsMode || openedFilePath.empty()) {
-    auto* res = tinyfd_saveFileDialog("Save File", nullptr, 1, Info::fileFilter, Info::fileDescription);
+    auto* res = tinyfd_saveFileDialog("Save File", nullptr, 2, Info::fileFilter, Info::fileDescription);
     if (res != nullptr) {
       openedFilePath = res;
     } else {
@@ -312,72 +692,332 @@ bool Persist::saveProject(EditorContext& ec, const bool saveAsMode) {
     }
   }
 
-  const int size = std::max(static_cast<int>(ec.core.nodes.size()), 1);
+  // One save at a time - the previous snapshot has to be written first
+  waitForSave(ec);
 
-  compIndices.reset();
+  // The journal belongs to the saved file - records up to here are dropped once the save is written
+  if (useJournal && journalPath != openedFilePath + Info::journalEnding) {
+    discardJournal();
+    openJournal(ec, false);
+  }
+  flushJournal();
+  journalSaved = journal != nullptr && fseek(journal, 0, SEEK_END) == 0 ? ftell(journal) : 0;
+
+  // The snapshot is what ends up in the file - later changes mark the project as unsaved again
+  auto* snapshot = TakeSnapshot(ec, openedFilePath);
+  ec.core.hasUnsavedChanges = false;
 
-  int nodes, connections;
-  //We assume 1000 bytes on average per node for the buffer
-  const auto res = io_save_buffered_write(openedFilePath.c_str(), size * 1000, [&](FILE* file) {
-    SaveEditorData(file, ec);
-    SaveTemplates(file, ec);
-    nodes = SaveNodes(file, ec);
-    connections = SaveConnections(file, ec);
-    SaveGroups(file, ec);
+  pendingSave = std::async(std::launch::async, [snapshot] {
+    // The format is chosen by the file ending
+    bool res;
+    if (snapshot->isBinary) {
+      res = SaveBinaryProject(*snapshot);
+    } else {
+      //We assume 1000 bytes on average per node for the buffer
+      const int size = std::max(static_cast<int>(snapshot->nodes.size()), 1);
+      res = io_save_buffered_write(snapshot->path.c_str(), size * 1000, [&](FILE* file) {
+        SaveEditorData(file, *snapshot);
+        SaveTemplates(file, *snapshot);
+        SaveNodes(file, *snapshot);
+        SaveConnections(file, *snapshot);
+        SaveGroups(file, *snapshot);
+      });
+    }
+    if (!res) fprintf(stderr, "Error saving to %s", snapshot->path.c_str());
+    snapshot->saved = res;
+    return snapshot;
   });
+  return true;
+}
+void Persist::update(EditorContext& ec) {
+  if (pendingSave.valid() && pendingSave.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+    waitForSave(ec);
+  }
 
-  if (!res) {
-    fprintf(stderr, "Error saving to %s", openedFilePath.c_str());
-    return false;
+  // Journal records are buffered - flushing every action would stall the frame on slow disks
+  if (journalDirty && std::chrono::steady_clock::now() - journalFlushed >= JOURNAL_FLUSH_INTERVAL) flushJournal();
+
+  if (pendingLoad == nullptr) return;
+  auto& load = *pendingLoad;
+  if (load.phase == ProjectLoad::READING) {
+    if (load.reading.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+    if (!load.reading.get()) return cancelLoad();
+    StartLoad(load, ec);
   }
+  if (StepLoad(load, ec, LOAD_BUDGET)) {
+    cancelLoad();
+    finishLoad(ec);
+  }
+}
+bool Persist::waitForSave(EditorContext& ec) {
+  if (!pendingSave.valid()) return true;
+  const auto* snapshot = pendingSave.get();
+  const bool res = snapshot->saved;
+  delete snapshot;
+
+  // Failed saves leave the changes unsaved
+  if (!res) ec.core.hasUnsavedChanges = true;
+  else compactJournal();
 
   // Successfully saved - reflect in the title
-  ec.core.hasUnsavedChanges = false;
   ec.string.updateWindowTitle(ec);
-
-  //printf("Saved %s nodes\n", ec.string.getPaddedNum(nodes));
-  //printf("Saved %s connections\n", ec.string.getPaddedNum(connections));
-  return true;
+  return res;
 }
-bool Persist::importProject(EditorContext& ec) {
+bool Persist::importProject(EditorContext& ec, const bool async) {
+  waitForSave(ec);   // The file might still be written
+  cancelLoad();      // A new import replaces a running one
+  discardJournal();  // Changes of the previous project were saved or discarded
+
   if (openedFilePath.empty()) {
     //TODO save and reuse default path
-    const auto* res = tinyfd_openFileDialog("Open File", nullptr, 1, Info::fileFilter, Info::fileDescription, 0);
+    const auto* res = tinyfd_openFileDialog("Open File", nullptr, 2, Info::fileFilter, Info::fileDescription, 0);
     if (res != nullptr) openedFilePath = res;
   }
 
-  const auto* path = openedFilePath.c_str();
+  auto* load = new ProjectLoad();
+  load->path = openedFilePath;
 
-  FILE* file = fopen(path, "rb");
+  if (async) {
+    // Finished over the next ticks inside update()
+    load->reading = std::async(std::launch::async, [load] { return load->read(); });
+    pendingLoad = load;
+    return true;
+  }
 
-  if (file == nullptr) {
-    fprintf(stderr, "Unable to open file %s\n", path);
-    return false;
+  const bool res = load->read();
+  if (res) {
+    StartLoad(*load, ec);
+    StepLoad(*load, ec, DBL_MAX);
+    finishLoad(ec);
   }
+  delete load;
+  return res;
+}
+void Persist::finishLoad(EditorContext& ec) {
+  // Successfully loaded - reflect in the title
+  ec.string.updateWindowTitle(ec);
+  fileName = GetFileName(openedFilePath.c_str());
 
-  // Reset editor to initial state
-  ec.core.resetEditor(ec);
-  compIndices.reset();
+  // Changes after the last save if the editor didn't exit cleanly
+  if (useJournal) openJournal(ec, true);
+}
+void Persist::cancelLoad() {
+  delete pendingLoad;  // Waits for the reading thread
+  pendingLoad = nullptr;
+}
+float Persist::getLoadProgress() const {
+  return pendingLoad == nullptr ? 1.0F : pendingLoad->getProgress();
+}
+
+//-----------JOURNAL-----------//
+namespace {
+// One record per line - the state after the change so replaying is independent of the undo history
+enum JournalRecord : uint8_t { J_NODE = 1, J_NODE_REMOVED, J_NODE_MOVED, J_CONNECTION, J_CONNECTION_REMOVED };
+void JournalNode(FILE* file, const Node& n) {
+  io_save(file, J_NODE);
+  io_save(file, n.name);
+  Node::SaveState(file, n);
+  io_save_newline(file);
+}
+void JournalConnection(FILE* file, const JournalRecord type, const Connection& conn) {
+  io_save(file, type);
+  SaveConnectionData(file, conn.getData());
+  io_save_newline(file);
+}
+// Nodes that come back bring their connections
+void JournalNodes(FILE* file, EditorContext& ec, const std::vector<Node*>& nodes) {
+  for (const auto n : nodes) {
+    JournalNode(file, *n);
+  }
+  for (const auto n : nodes) {
+    for (const auto conn : ec.core.getConnections(*n)) {
+      JournalConnection(file, J_CONNECTION, *conn);
+    }
+  }
+}
+void JournalRemovedNodes(FILE* file, const std::vector<Node*>& nodes) {
+  for (const auto n : nodes) {
+    io_save(file, J_NODE_REMOVED);
+    io_save(file, static_cast<int>(n->uID));
+    io_save_newline(file);
+  }
+}
+void JournalConnections(FILE* file, const JournalRecord type, const std::vector<Connection*>& connections) {
+  for (const auto conn : connections) {
+    JournalConnection(file, type, *conn);
+  }
+}
+// Returns the live connection with the given endpoints
+Connection* FindConnection(EditorContext& ec, const ConnectionData& data) {
+  const auto* fromNode = ec.core.getNode(static_cast<NodeID>(data.fromNode));
+  if (fromNode == nullptr) return nullptr;
+  for (const auto conn : ec.core.getConnections(*fromNode)) {
+    if (&conn->fromNode != fromNode) continue;
+    const auto other = conn->getData();
+    if (other.from == data.from && other.out == data.out && other.toNode == data.toNode && other.to == data.to
+        && other.in == data.in) {
+      return conn;
+    }
+  }
+  return nullptr;
+}
+// Applies the journal on top of the loaded project - returns the amount of applied records
+int ReplayJournal(ByteReader& reader, EditorContext& ec) {
+  // A crash can cut off the last record
+  while (reader.end > reader.cursor && reader.end[-1] != '\n') {
+    --reader.end;
+  }
+
+  int count = 0;
+  char name[PLG_MAX_NAME_LEN];
+  while (reader.cursor < reader.end) {
+    int type = 0;
+    io_load(reader, type);
+    if (type == J_NODE) {
+      io_load(reader, name, PLG_MAX_NAME_LEN);
+      int id;
+      io_load(reader, id);
+      auto* node = ec.core.getNode(static_cast<NodeID>(id));
+      if (node == nullptr) node = ec.core.createAddNode(ec, name, {0, 0}, static_cast<uint32_t>(id));
+      if (node == nullptr) {
+        io_load_newline(reader, true);
+        continue;
+      }
+      Node::LoadState(reader, *node);
+      ec.core.grid.update(*node);
+      ec.core.UID = std::max(ec.core.UID, static_cast<NodeID>(node->uID + 1));
+    } else if (type == J_NODE_REMOVED || type == J_NODE_MOVED) {
+      int id;
+      io_load(reader, id);
+      auto* node = ec.core.getNode(static_cast<NodeID>(id));
+      if (node != nullptr && type == J_NODE_MOVED) {
+        io_load(reader, node->x);
+        io_load(reader, node->y);
+        ec.core.grid.update(*node);
+      } else if (node != nullptr) {
+        std::vector<Connection*> removed;
+        ec.core.removeConnectionsFromNode(*node, removed);
+        ec.core.removeNode(ec, node->uID);
+        for (const auto conn : removed) {
+          delete conn;
+        }
+        delete node;
+      }
+    } else if (type == J_CONNECTION || type == J_CONNECTION_REMOVED) {
+      const auto data = LoadConnectionData(reader);
+      auto* existing = FindConnection(ec, data);
+      if (type == J_CONNECTION_REMOVED && existing != nullptr) {
+        ec.core.removeConnection(existing);
+        delete existing;
+      } else if (type == J_CONNECTION && existing == nullptr) {
+        CreateNewConnection(ec, data);
+      }
+    }
+    io_load_newline(reader, true);
+    count++;
+  }
+  return count;
+}
+}  // namespace
 
-  //Load data
-  int nodes = 0;
-  int connections = 0;
-  LoadEditorData(file, ec);
-  LoadTemplates(file);
-  nodes = LoadNodes(file, ec);
-  connections = LoadConnections(file, ec);
-  LoadGroups(file, ec);
+void Persist::journalAction(EditorContext& ec, const Action& action, const bool undone) {
+  if (journalPath.empty() || action.type == NEW_CANVAS_ACTION) return;
+  if (journal == nullptr) journal = fopen(journalPath.c_str(), "ab");
+  if (journal == nullptr) return;
 
-  //printf("Loaded %s nodes\n", ec.string.getPaddedNum(nodes));
-  //printf("Loaded %s connections\n", ec.string.getPaddedNum(connections));
+  switch (action.type) {
+    case MOVE_NODE:
+      for (const auto& [id, delta] : static_cast<const NodeMovedAction&>(action).movedNodes) {
+        const auto* node = ec.core.getNode(id);
+        if (node == nullptr) continue;
+        io_save(journal, J_NODE_MOVED);
+        io_save(journal, static_cast<int>(id));
+        io_save(journal, node->x);
+        io_save(journal, node->y);
+        io_save_newline(journal);
+      }
+      break;
+    case TEXT_EDIT:
+      if (const auto* node = ec.core.getNode(static_cast<const TextAction&>(action).node)) JournalNode(journal, *node);
+      break;
+    case DELETE_NODE: {
+      const auto& deleted = static_cast<const NodeDeleteAction&>(action).deletedNodes;
+      if (undone) JournalNodes(journal, ec, deleted);
+      else JournalRemovedNodes(journal, deleted);
+      break;
+    }
+    case CREATE_NODE: {
+      const auto& created = static_cast<const NodeCreateAction&>(action).createdNodes;
+      if (undone) JournalRemovedNodes(journal, created);
+      else JournalNodes(journal, ec, created);
+      break;
+    }
+    case CONNECTION_CREATED:
+      JournalConnections(journal, undone ? J_CONNECTION_REMOVED : J_CONNECTION,
+                         static_cast<const ConnectionCreateAction&>(action).createdConnections);
+      break;
+    case CONNECTION_DELETED:
+      JournalConnections(journal, undone ? J_CONNECTION : J_CONNECTION_REMOVED,
+                         static_cast<const ConnectionDeleteAction&>(action).deletedConnections);
+      break;
+    case NEW_CANVAS_ACTION:
+      break;
+  }
+  journalDirty = true;
+}
+void Persist::flushJournal() {
+  if (journal != nullptr) fflush(journal);
+  journalFlushed = std::chrono::steady_clock::now();
+  journalDirty = false;
+}
+void Persist::closeJournal() {
+  flushJournal();
+  if (journal != nullptr) fclose(journal);
+  journal = nullptr;
+}
+void Persist::discardJournal() {
+  closeJournal();
+  if (!journalPath.empty()) remove(journalPath.c_str());
+  journalPath.clear();
+  journalSaved = 0;
+}
+void Persist::openJournal(EditorContext& ec, const bool replay) {
+  journalPath = openedFilePath + Info::journalEnding;
+  journalSaved = 0;
+  if (!replay) {
+    remove(journalPath.c_str());  // Left over from another project with the same name
+    return;
+  }
 
-  if (fclose(file) != 0) return false;
+  ByteReader reader;
+  if (!reader.open(journalPath.c_str())) return;
+  const int records = ReplayJournal(reader, ec);
+  if (records == 0) return;
 
-  // Successfully loaded - reflect in the title
+  // The recovered changes aren't in the project file yet
+  fprintf(stderr, "Recovered %d changes from %s\n", records, journalPath.c_str());
+  ec.core.hasUnsavedChanges = true;
   ec.string.updateWindowTitle(ec);
-  fileName = GetFileName(openedFilePath.c_str());
+  journal = fopen(journalPath.c_str(), "ab");
+}
+// Drops the records contained in the last save
+void Persist::compactJournal() {
+  if (journalSaved == 0) return;
+  closeJournal();
 
-  return true;
+  ByteReader reader;
+  const bool hasJournal = reader.open(journalPath.c_str());
+  const auto size = hasJournal ? reader.end - reader.cursor : 0;
+  if (size > journalSaved) {
+    FILE* file = fopen(journalPath.c_str(), "wb");
+    if (file != nullptr) {
+      fwrite(reader.cursor + journalSaved, 1, static_cast<size_t>(size - journalSaved), file);
+      fclose(file);
+    }
+  } else {
+    remove(journalPath.c_str());
+  }
+  journalSaved = 0;
 }
 
 //-----------USER_FILES-----------//
@@ -482,109 +1122,121 @@ bool Persist::saveUserTemplates(EditorContext& ec) {
 
 bool Persist::importNodesFromProject(EditorContext& ec) {
   const auto title = "Select project to import nodes from";
-  const auto* res = tinyfd_openFileDialog(title, nullptr, 1, Info::fileFilter, Info::fileDescription, 0);
+  const auto* res = tinyfd_openFileDialog(title, nullptr, 2, Info::fileFilter, Info::fileDescription, 0);
   if (res == nullptr) return false;
 
-  const auto loadFunc = [](EditorContext& ec, FILE* file) {
-    compIndices.reset();
+  ByteReader reader;
+  if (!reader.open(res)) {
+    fprintf(stderr, "Unable to open file %s\n", res);
+    return true;
+  }
+
+  const bool isBinary = BinaryProject::IsBinary(reader);
+  BinaryProject project;
+  if (isBinary && !project.open(reader)) {
+    fprintf(stderr, "Invalid binary project %s\n", res);
+    return true;
+  }
+
+  compIndices.reset();
+  if (!isBinary) {
     // Skip Editor Data
-    io_load_newline(file, true);
-    io_load_newline(file, true);
+    io_load_newline(reader, true);
+    io_load_newline(reader, true);
 
     // Load templates
-    LoadTemplates(file);
+    LoadTemplates(reader);
+  }
 
-    auto* action = new NodeCreateAction(10);
+  auto* action = new NodeCreateAction(10);
 
-    // Adding the current to the used id allows us to map back connections uniquely
-    const auto startID = ec.core.UID;
+  // Adding the current to the used id allows us to map back connections uniquely
+  const auto startID = ec.core.UID;
 
-    // Nodes are imported such that import point is the top left corner
-    const Vector2 contextWorldPos = GetScreenToWorld2D(ec.logic.contextMenuPos, ec.display.camera);
-    float minX = FLT_MAX;
-    float minY = FLT_MAX;
+  // Nodes are imported such that import point is the top left corner
+  const Vector2 contextWorldPos = GetScreenToWorld2D(ec.logic.contextMenuPos, ec.display.camera);
+  float minX = FLT_MAX;
+  float minY = FLT_MAX;
 
-    // Load the nodes
-    while (io_load_inside_section(file, "Nodes")) {
-      int index = -1;
-      io_load(file, index);
-      if (index == -1) {
-        io_load_newline(file, true);
-        continue;
-      }
+  if (isBinary) {
+    const auto templates = LoadTemplates(project.sections[RNB_TEMPLATES]);
+    LoadNodes(project.sections[RNB_NODES], ec, templates, startID, &action->createdNodes);
+    LoadConnections(project.sections[RNB_CONNECTIONS], ec, startID, INT32_MAX, &action->createdConnection);
+  }
+
+  // Load the nodes
+  while (!isBinary && io_load_inside_section(reader, "Nodes")) {
+    int index = -1;
+    io_load(reader, index);
+    if (index == -1) {
+      io_load_newline(reader, true);
+      continue;
+    }
+    int id;
+    io_load(reader, id);
+    auto* nodeName = compIndices.getName(index);
+    const auto newNode = ec.core.createAddNode(ec, nodeName, {0, 0}, startID + id);
+    if (!newNode) {
+      io_load_newline(reader, true);
+      continue;
+    }
+    Node::LoadState(reader, *newNode);
+
+    io_load_newline(reader);
+    action->createdNodes.push_back(newNode);
+  }
+
+  // Load the connections
+  while (!isBinary && io_load_inside_section(reader, "Connections")) {
+    auto data = LoadConnectionData(reader);
+    data.fromNode += startID;
+    data.toNode += startID;
+    if (IsValidConnection(INT32_MAX, data)) {
+      if (auto* conn = CreateNewConnection(ec, data)) action->createdConnection.push_back(conn);
+    }
+    io_load_newline(reader);
+  }
+
+  // Update the minimum position
+  for (const auto* newNode : action->createdNodes) {
+    minX = std::min(minX, newNode->x);
+    minY = std::min(minY, newNode->y);
+  }
+
+  // Offset the nodes so they are positioned as specified above
+  const Vector2 offset = {contextWorldPos.x - minX, contextWorldPos.y - minY};
+  for (auto* newNode : action->createdNodes) {
+    newNode->x += offset.x;
+    newNode->y += offset.y;
+    ec.core.grid.update(*newNode);
+  }
+
+  if (isBinary) LoadGroups(project.sections[RNB_GROUPS], ec, startID);
+
+  while (!isBinary && io_load_inside_section(reader, "Groups")) {
+    int x, y;
+    char buff[PLG_MAX_NAME_LEN];
+    bool expanded;
+    io_load(reader, x);
+    io_load(reader, y);
+    io_load(reader, buff, PLG_MAX_NAME_LEN);
+    io_load(reader, expanded);
+    auto& ng = ec.core.nodeGroups.emplace_back(static_cast<float>(x), static_cast<float>(y), buff, expanded);
+    while (!io_load_is_newline(reader)) {
       int id;
-      io_load(file, id);
-      auto* nodeName = compIndices.getName(index);
-      const auto newNode = ec.core.createAddNode(ec, nodeName, {0, 0}, startID + id);
-      if (!newNode) {
-        io_load_newline(file, true);
-        continue;
-      }
-      Node::LoadState(file, *newNode);
-
-      io_load_newline(file);
-      action->createdNodes.push_back(newNode);
-
-      // Update the minimum position
-      if (newNode->x < minX) minX = newNode->x;
-      if (newNode->y < minY) minY = newNode->y;
-    }
-
-    // Load the connections
-    while (io_load_inside_section(file, "Connections")) {
-      int fromNode, from, out;
-      int toNode, to, in;
-      //Output
-      io_load(file, fromNode);
-      io_load(file, from);
-      io_load(file, out);
-      //Input
-      io_load(file, toNode);
-      io_load(file, to);
-      io_load(file, in);
-      fromNode += startID;
-      toNode += startID;
-      if (IsValidConnection(UINT16_MAX, fromNode, from, out, toNode, to, in)) {
-        auto* conn = CreateNewConnection(ec, fromNode, from, out, toNode, to, in);
-        action->createdConnection.push_back(conn);
-      }
-      io_load_newline(file);
-    }
-
-    // Offset the nodes so they are positioned as specified above
-    const Vector2 offset = {contextWorldPos.x - minX, contextWorldPos.y - minY};
-    for (auto* newNode : action->createdNodes) {
-      newNode->x += offset.x;
-      newNode->y += offset.y;
-    }
-
-    while (io_load_inside_section(file, "Groups")) {
-      int x, y;
-      char buff[PLG_MAX_NAME_LEN];
-      bool expanded;
-      io_load(file, x);
-      io_load(file, y);
-      io_load(file, buff, PLG_MAX_NAME_LEN);
-      io_load(file, expanded);
-      auto& ng = ec.core.nodeGroups.emplace_back(static_cast<float>(x), static_cast<float>(y), buff, expanded);
-      while (!io_load_is_newline(file)) {
-        int id;
-        io_load(file, id);
-        auto* node = ec.core.getNode(static_cast<NodeID>(startID + id));
-        // To get the correct dimensions
-        if (node) {
-          Node::Draw(ec, *node);
-          Node::Update(ec, *node);
-          ng.addNode(ec, *node);
-        }
+      io_load(reader, id);
+      auto* node = ec.core.getNode(static_cast<NodeID>(startID + id));
+      // To get the correct dimensions
+      if (node) {
+        Node::Draw(ec, *node);
+        Node::Update(ec, *node);
+        ng.addNode(ec, *node);
       }
-      io_load_newline(file, true);
     }
+    io_load_newline(reader, true);
+  }
 
-    ec.core.UID = static_cast<NodeID>(startID + action->createdNodes.size());
-    ec.core.addEditorAction(ec, action);
-    return true;
-  };
-
-  return LoadFromFile(ec, res, loadFunc);
+  ec.core.UID = static_cast<NodeID>(startID + action->createdNodes.size());
+  ec.core.addEditorAction(ec, action);
+  return true;
 }
\ No newline at end of file
@@ -57,7 +57,15 @@ void RegisterPlugin(EditorContext& ec, PluginContainer& pc) {
 }  // namespace
 
 bool Plugin::loadPlugins(EditorContext& ec) {
-  const char* basePath = ec.string.formatText("%s%s", ec.string.applicationDir, PLUGIN_PATH);
+  return loadPlugins(ec, ec.string.formatText("%s%s", ec.string.applicationDir, PLUGIN_PATH));
+}
+
+bool Plugin::loadPlugins(EditorContext& ec, const char* directory) {
+  if (!std::filesystem::is_directory(directory)) {
+    fprintf(stderr, "Plugin directory not found: %s\n", directory);
+    return false;
+  }
+  const std::string basePath = directory;  // Copied - formatText buffers are reused
   const char* filter;
 #if defined(_WIN32)
   filter = ".dll";
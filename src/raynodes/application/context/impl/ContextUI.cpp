@@ -155,6 +155,7 @@ void UI::invokeFileMenu(EditorContext& ec, int i) {
 }
 void UI::invokeEditMenu(EditorContext& ec, int i) {
   if (i == -1 || i == 0) return;
+  if (ec.persist.isLoading()) return;  // Pasted nodes would take ids of nodes that are still loaded
 
   if (i == 1) ec.core.undo(ec);
   if (i == 2) ec.core.redo(ec);
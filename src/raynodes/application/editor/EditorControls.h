@@ -40,6 +40,14 @@ void HandleMoveAction(EditorContext& ec) {
     moveAction = nullptr;
   }
 }
+void MoveCamera(EditorContext& ec) {
+  auto& camera = ec.display.camera;
+  const auto moveSpeed = 10 - camera.zoom;
+  if (ec.input.isKeyDown(KEY_UP)) { camera.target.y -= moveSpeed; }
+  if (ec.input.isKeyDown(KEY_LEFT)) { camera.target.x -= moveSpeed; }
+  if (ec.input.isKeyDown(KEY_DOWN)) { camera.target.y += moveSpeed; }
+  if (ec.input.isKeyDown(KEY_RIGHT)) { camera.target.x += moveSpeed; }
+}
 }  // namespace
 
 inline void PollControls(EditorContext& ec) {
@@ -51,6 +59,7 @@ inline void PollControls(EditorContext& ec) {
   auto& selectRect = ec.logic.selectRect;
   auto& selectedNodes = ec.core.selectedNodes;
   auto& contextMenuPos = ec.logic.contextMenuPos;
+  const bool isLoading = ec.persist.isLoading();  // Only the camera moves while a project streams in
 
   if (!ec.input.mouseConsumed) {
     camera.zoom += GetMouseWheelMove() * 0.05f;
@@ -61,7 +70,7 @@ inline void PollControls(EditorContext& ec) {
   if (ec.input.isMBPressed(MOUSE_BUTTON_RIGHT)) { contextMenuPos = mouse; }
 
   //Context menus
-  if (ec.input.isMBReleased(MOUSE_BUTTON_RIGHT)) {
+  if (!isLoading && ec.input.isMBReleased(MOUSE_BUTTON_RIGHT)) {
     if (DistEuclidean(contextMenuPos, mouse) <= 5.0F) {
       if (ec.logic.isAnyPinHovered) {
         //TODO pin menu
@@ -80,7 +89,7 @@ inline void PollControls(EditorContext& ec) {
   }
 
   // Node Search menu
-  if (ec.input.isKeyPressed(KEY_TAB)) {
+  if (!isLoading && ec.input.isKeyPressed(KEY_TAB)) {
     ec.logic.contextMenuPos = ec.logic.mouse;
     ec.ui.canvasContextMenu.hide();
     ec.ui.nodeCreateMenu.show();
@@ -107,7 +116,8 @@ inline void PollControls(EditorContext& ec) {
   }
 
   //Selecting
-  if (ec.input.isMBPressed(MOUSE_BUTTON_RIGHT) && !ec.logic.isAnyNodeHovered && !ec.ui.nodeCreateMenu.isVisible) {
+  if (!isLoading && ec.input.isMBPressed(MOUSE_BUTTON_RIGHT) && !ec.logic.isAnyNodeHovered
+      && !ec.ui.nodeCreateMenu.isVisible) {
     ec.logic.isSelecting = true;
     ec.logic.selectPoint = worldMouse;
     selectRect.width = 0;
@@ -117,6 +127,12 @@ inline void PollControls(EditorContext& ec) {
 
   if (ec.input.isMBReleased(MOUSE_BUTTON_RIGHT)) { ec.logic.isSelecting = false; }
 
+  // Editing could reference nodes that aren't loaded yet
+  if (isLoading) {
+    MoveCamera(ec);
+    return;
+  }
+
   //Delete
   if (ec.input.isKeyPressed(KEY_DELETE) || ec.input.isKeyPressed(KEY_BACKSPACE)) { ec.core.erase(ec); }
 
@@ -155,12 +171,7 @@ inline void PollControls(EditorContext& ec) {
     }
   }
 
-  // Move camera
-  const auto moveSpeed = 10 - camera.zoom;
-  if (ec.input.isKeyDown(KEY_UP)) { camera.target.y -= moveSpeed; }
-  if (ec.input.isKeyDown(KEY_LEFT)) { camera.target.x -= moveSpeed; }
-  if (ec.input.isKeyDown(KEY_DOWN)) { camera.target.y += moveSpeed; }
-  if (ec.input.isKeyDown(KEY_RIGHT)) { camera.target.x += moveSpeed; }
+  MoveCamera(ec);
 }
 
 }  // namespace Editor
@@ -23,13 +23,17 @@
 
 namespace Editor {
 inline void DrawNodes(EditorContext& ec) {
-  const auto& nodes = ec.core.nodes;
+  auto& visible = ec.logic.queryNodes;
   const auto topLeft = GetScreenToWorld2D({0, 0}, ec.display.camera);
   const auto bottomRight = GetScreenToWorld2D(ec.display.screenSize, ec.display.camera);
 
   const Rectangle cameraBounds = {topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y};
 
-  for (const auto n : nodes) {
+  visible.clear();
+  ec.core.grid.query(cameraBounds, visible);
+  std::ranges::sort(visible, [](const Node* n1, const Node* n2) { return n1->zIndex < n2->zIndex; });
+
+  for (const auto n : visible) {
     if (CheckCollisionRecs(cameraBounds, n->getBounds())) { Node::Draw(ec, *n); }
   }
 }
@@ -50,12 +54,15 @@ inline void DrawConnections(EditorContext& ec, const bool isCTRLDown) {
 
     if (delNodes && CheckCollisionBezierRect(fromPos, toPos, selectRect)) {
       action->deletedConnections.push_back(conn);
-      NodeGroup::InvokeConnection(ec,conn->toNode);
-      NodeGroup::InvokeConnection(ec,conn->fromNode);
-      ec.core.removeConnection(conn);
     }
   }
   if (delNodes) [[unlikely]] {
+    // Removing reorders the connections - so only after iterating
+    for (const auto conn : action->deletedConnections) {
+      NodeGroup::InvokeConnection(ec, conn->toNode);
+      NodeGroup::InvokeConnection(ec, conn->fromNode);
+      ec.core.removeConnection(conn);
+    }
     if (action->deletedConnections.empty()) delete action;
     else ec.core.addEditorAction(ec, action);
   }
@@ -23,6 +23,9 @@
 
 namespace Editor {
 inline bool ExitEditor(EditorContext& ec) {
+  ec.persist.waitForSave(ec);  // Don't cut off a background save
+  ec.persist.cancelLoad();
+  ec.persist.discardJournal();  // Clean exit - changes are saved or discarded by the user
 
   ec.persist.saveUserTemplates(ec);
 
@@ -178,6 +178,14 @@ inline void DrawStatusBar(EditorContext& ec) {
     statusBar(ec, leftPanels, y, 150.0F, height, text);
     text = ec.string.formatText("#070# Connections: %d", (int)ec.core.connections.size());
     statusBar(ec, leftPanels, y, 180.0F, height, text);
+
+    // Progress of an async import
+    if (ec.persist.isLoading()) {
+      statusBar(ec, leftPanels, y, 200.0F, height, nullptr);
+      float progress = ec.persist.getLoadProgress();
+      const auto bounds = ec.display.getFullyScaled({leftPanels - 195.0F, y + 4.0F, 190.0F, height - 8.0F});
+      GuiProgressBar(bounds, nullptr, nullptr, &progress, 0.0F, 1.0F);
+    }
   }
 
   // Right panels
@@ -57,23 +57,45 @@ void FormatSelectRectangle(EditorContext& ec) {
     }
   }
 }
+
+// Selects all nodes inside the selection rectangle
+void SelectNodes(EditorContext& ec) {
+  auto& selectedNodes = ec.core.selectedNodes;
+  auto& candidates = ec.logic.queryNodes;
+  const auto selectRect = ec.logic.selectRect;
+
+  selectedNodes.clear();
+  candidates.clear();
+  ec.core.grid.query(selectRect, candidates);
+  for (const auto n : candidates) {
+    if (n->isInGroup || !CheckCollisionRecs(n->getBounds(), selectRect)) continue;
+    selectedNodes.insert({n->uID, n});
+    n->isHovered = true;
+    ec.logic.isAnyNodeHovered = true;
+    ec.logic.hoveredNode = n;
+  }
+}
 }  // namespace
 
 namespace Editor {
 inline void UpdateTick(EditorContext& ec) {
   ec.logic.hoveredGroup = nullptr;  // Reset each tick
 
-  //Reverse update to correctly reflect input layers
-  for (auto it = ec.core.nodes.rbegin(); it != ec.core.nodes.rend(); ++it) {
-    Node::Update(ec, **it);
+  //Only nodes close to the mouse need hover and pin checks
+  ec.logic.mouseNodes.clear();
+  ec.core.grid.query(ec.logic.worldMouse, ec.logic.mouseNodes);
+
+  ec.core.updateNodes(ec, GetFrameTime());
+
+  if (ec.logic.isSelecting) [[unlikely]] {
+    FormatSelectRectangle(ec);
+    SelectNodes(ec);
   }
 
   // Reverse update groups
   for (auto it = ec.core.nodeGroups.rbegin(); it != ec.core.nodeGroups.rend(); ++it) {
     it->update(ec);
   }
-
-  if (ec.logic.isSelecting) { FormatSelectRectangle(ec); }
 }
 // Called at the start of each tick
 inline void StartUpdateTick(EditorContext& ec) {
@@ -101,6 +123,8 @@ inline void StartUpdateTick(EditorContext& ec) {
 
   ec.input.reset();  //Reset input for tick
 
+  ec.persist.update(ec);  // Finish a background save
+
   // raygui text size - 16 per default
   const auto scaleY = ec.display.screenSize.y / 1080.0F;
   const auto fontSize = fmaxf(13.0F, std::round(13.0F * scaleY));
@@ -23,12 +23,58 @@
 #include "application/EditorContext.h"
 #include "node/Node.h"
 
+namespace {
+constexpr size_t COMPONENT_MEMORY = 256;                // Estimate for a component with its pins and buffers
+constexpr size_t MAX_PACKED_SIZE = 64 * 1024 * 1024;  // Limit of DecompressData()
+
+size_t GetNodeMemory(const std::vector<Node*>& nodes) {
+  size_t bytes = nodes.capacity() * sizeof(Node*);
+  for (const auto n : nodes) {
+    bytes += sizeof(Node) + n->components.size() * COMPONENT_MEMORY;
+  }
+  return bytes;
+}
+size_t GetConnectionMemory(const std::vector<Connection*>& connections, const bool owned) {
+  return connections.capacity() * sizeof(Connection*) + (owned ? connections.size() * sizeof(Connection) : 0);
+}
+// Replaces the text between the unchanged prefix and suffix
+void ReplaceMiddle(std::string& text, const uint32_t prefix, const uint32_t suffix, const std::string& middle) {
+  const size_t start = std::min<size_t>(prefix, text.size());
+  const size_t end = std::max(start, text.size() - std::min<size_t>(suffix, text.size()));
+  text.replace(start, end - start, middle);
+}
+}  // namespace
+
 void TextAction::undo(EditorContext& /**/) {
-  targetText = beforeState;
+  if (isDelta) ReplaceMiddle(targetText, prefix, suffix, beforeState);
+  else targetText = beforeState;
 }
 
 void TextAction::redo(EditorContext& /**/) {
-  targetText = afterState;
+  if (isDelta) ReplaceMiddle(targetText, prefix, suffix, afterState);
+  else targetText = afterState;
+}
+
+size_t TextAction::getMemory() const {
+  return sizeof(TextAction) + beforeState.capacity() + afterState.capacity();
+}
+
+void TextAction::compact() {
+  if (isDelta) return;
+  const size_t common = std::min(beforeState.size(), afterState.size());
+  size_t start = 0;
+  while (start < common && beforeState[start] == afterState[start]) ++start;
+  size_t end = 0;
+  while (end < common - start && beforeState[beforeState.size() - 1 - end] == afterState[afterState.size() - 1 - end]) {
+    ++end;
+  }
+  beforeState = beforeState.substr(start, beforeState.size() - start - end);
+  afterState = afterState.substr(start, afterState.size() - start - end);
+  beforeState.shrink_to_fit();
+  afterState.shrink_to_fit();
+  prefix = static_cast<uint32_t>(start);
+  suffix = static_cast<uint32_t>(end);
+  isDelta = true;
 }
 
 //-----------NODE_DELETE-----------//
@@ -37,11 +83,11 @@ NodeDeleteAction::NodeDeleteAction(EditorContext& ec, const std::unordered_map<N
   deletedNodes.reserve(selectedNodes.size() + 1);
   deletedConnections.reserve(selectedNodes.size() / 5);  //Just guessing
 
-  for (auto [id, node] : selectedNodes) {
-    ec.core.removeNode(ec, id);
-    ec.core.removeConnectionsFromNode(*node, deletedConnections);
+  for (const auto [id, node] : selectedNodes) {
     deletedNodes.push_back(node);
   }
+  ec.core.removeNodes(ec, deletedNodes);
+  ec.core.removeConnectionsFromNodes(deletedNodes, deletedConnections);
 }
 
 NodeDeleteAction::~NodeDeleteAction() noexcept {
@@ -56,6 +102,7 @@ NodeDeleteAction::~NodeDeleteAction() noexcept {
 
 void NodeDeleteAction::undo(EditorContext& ec) {
   hasOwnerShip = false;
+  if (isCompact()) return restore(ec);
   for (const auto n : deletedNodes) {
     ec.core.insertNode(ec, *n);
   }
@@ -67,10 +114,90 @@ void NodeDeleteAction::undo(EditorContext& ec) {
 
 void NodeDeleteAction::redo(EditorContext& ec) {
   hasOwnerShip = true;
+  ec.core.removeNodes(ec, deletedNodes);
+  ec.core.removeConnectionsFromNodes(deletedNodes, deletedConnections);
+}
+
+size_t NodeDeleteAction::getMemory() const {
+  size_t bytes = sizeof(NodeDeleteAction) + packed.capacity();
+  for (const auto& str : packedStrings) {
+    bytes += sizeof(std::string) + str.capacity();
+  }
+  if (hasOwnerShip) bytes += GetNodeMemory(deletedNodes);
+  return bytes + GetConnectionMemory(deletedConnections, hasOwnerShip);
+}
+
+// Layout: node count, per node its name and state blob (Node::SaveState), connection count, per connection its ids
+void NodeDeleteAction::compact() {
+  if (!hasOwnerShip || isCompact() || deletedNodes.empty()) return;
+
+  StringTable strings;
+  BinaryWriter writer{&strings};
+  BinaryWriter node{&strings};
+  writer.writeVarint(deletedNodes.size());
+  for (const auto n : deletedNodes) {
+    writer.writeString(n->name);
+    node.clear();
+    Node::SaveState(node, *n);
+    writer.writeBlob(node.data.data(), node.data.size());
+  }
+  writer.writeVarint(deletedConnections.size());
+  for (const auto conn : deletedConnections) {
+    conn->getData().save(writer);
+  }
+  if (writer.data.size() > MAX_PACKED_SIZE) return;
+
+  int size = 0;
+  unsigned char* data = CompressData(writer.data.data(), static_cast<int>(writer.data.size()), &size);
+  if (data == nullptr || size <= 0) {
+    MemFree(data);
+    return;
+  }
+  packed.assign(data, data + size);
+  MemFree(data);
+  packedStrings = std::move(strings.strings);
+
   for (const auto n : deletedNodes) {
-    ec.core.removeNode(ec, n->uID);
-    ec.core.removeConnectionsFromNode(*n, deletedConnections);
+    delete n;
+  }
+  for (const auto conn : deletedConnections) {
+    delete conn;
   }
+  deletedNodes = {};
+  deletedConnections = {};
+}
+
+// Nodes keep their ids - connections are resolved through them
+void NodeDeleteAction::restore(EditorContext& ec) {
+  int size = 0;
+  unsigned char* data = DecompressData(packed.data(), static_cast<int>(packed.size()), &size);
+  std::vector<std::string_view> strings{packedStrings.begin(), packedStrings.end()};
+  BinaryReader reader{data, data == nullptr ? 0 : static_cast<size_t>(size), &strings};
+
+  const auto nodeCount = reader.readVarint();
+  for (uint64_t i = 0; i < nodeCount && !reader.failed; ++i) {
+    const std::string name{reader.readString()};
+    BinaryReader state = reader.readBlob();
+    const auto id = static_cast<NodeID>(state.readVarint());
+    Node* n = ec.templates.createNode(ec, name.c_str(), {0, 0}, id);
+    if (n == nullptr) continue;
+    Node::LoadState(state, *n);
+    if (state.failed) fprintf(stderr, "Restored node %u has damaged component data\n", n->uID);
+    ec.core.insertNode(ec, *n);
+    deletedNodes.push_back(n);
+  }
+
+  const auto connectionCount = reader.readVarint();
+  for (uint64_t i = 0; i < connectionCount && !reader.failed; ++i) {
+    ConnectionData data{};
+    data.load(reader);
+    if (reader.failed) break;
+    if (auto* conn = Connection::Create(ec, data)) ec.core.addConnection(conn);
+  }
+
+  MemFree(data);
+  packed = {};
+  packedStrings = {};
 }
 
 //-----------NODE_CREATE-----------//
@@ -92,10 +219,8 @@ NodeCreateAction::~NodeCreateAction() noexcept {
 
 void NodeCreateAction::undo(EditorContext& ec) {
   hasOwnerShip = true;
-  for (const auto n : createdNodes) {
-    ec.core.removeNode(ec, n->uID);
-    ec.core.removeConnectionsFromNode(*n, createdConnection);
-  }
+  ec.core.removeNodes(ec, createdNodes);
+  ec.core.removeConnectionsFromNodes(createdNodes, createdConnection);
 }
 
 void NodeCreateAction::redo(EditorContext& ec) {
@@ -109,6 +234,11 @@ void NodeCreateAction::redo(EditorContext& ec) {
   createdConnection.clear();
 }
 
+size_t NodeCreateAction::getMemory() const {
+  return sizeof(NodeCreateAction) + (hasOwnerShip ? GetNodeMemory(createdNodes) : createdNodes.capacity() * sizeof(Node*)) +
+         GetConnectionMemory(createdConnection, hasOwnerShip);
+}
+
 //-----------NODE_MOVE-----------//
 NodeMovedAction::NodeMovedAction(const int size) : Action(MOVE_NODE) {
   movedNodes.reserve(size);
@@ -119,6 +249,7 @@ void NodeMovedAction::undo(EditorContext& ec) {
     const auto node = ec.core.getNode(id);
     node->x += delta.x;
     node->y += delta.y;
+    ec.core.grid.update(*node);
   }
 }
 
@@ -127,9 +258,14 @@ void NodeMovedAction::redo(EditorContext& ec) {
     const auto node = ec.core.getNode(id);
     node->x -= delta.x;
     node->y -= delta.y;
+    ec.core.grid.update(*node);
   }
 }
 
+size_t NodeMovedAction::getMemory() const {
+  return sizeof(NodeMovedAction) + movedNodes.capacity() * sizeof(movedNodes[0]);
+}
+
 float NodeMovedAction::calculateDeltas(EditorContext& ec) {
   auto& selectedNodes = ec.core.selectedNodes;
   for (auto& [id, delta] : movedNodes) {
@@ -170,6 +306,10 @@ void ConnectionDeleteAction::redo(EditorContext& ec) {
   }
 }
 
+size_t ConnectionDeleteAction::getMemory() const {
+  return sizeof(ConnectionDeleteAction) + GetConnectionMemory(deletedConnections, hasOwnerShip);
+}
+
 //-----------CONNECTION_CREATE-----------//
 
 ConnectionCreateAction::ConnectionCreateAction(const int size) : Action(CONNECTION_CREATED) {
@@ -196,4 +336,8 @@ void ConnectionCreateAction::redo(EditorContext& ec) {
     ec.core.addConnection(conn);
   }
   hasOwnerShip = false;
+}
+
+size_t ConnectionCreateAction::getMemory() const {
+  return sizeof(ConnectionCreateAction) + GetConnectionMemory(createdConnections, hasOwnerShip);
 }
\ No newline at end of file
@@ -47,6 +47,8 @@ struct EXPORT Action {
   virtual ~Action() noexcept = default;
   virtual void undo(EditorContext& ec) = 0;
   virtual void redo(EditorContext& ec) = 0;
+  // Approximate bytes held by the action - the undo history is limited by it
+  [[nodiscard]] virtual size_t getMemory() const { return sizeof(Action); }
 
   //Allows for custom strings with context specific information
   [[nodiscard]] virtual const char* toString() const {
@@ -70,7 +72,7 @@ struct EXPORT Action {
   }
 };
 
-struct NewCanvasAction final : Action {
+struct EXPORT NewCanvasAction final : Action {
   NewCanvasAction() : Action(NEW_CANVAS_ACTION) {}
   void undo(EditorContext& /**/) override {}
   void redo(EditorContext& /**/) override {}
@@ -80,64 +82,86 @@ struct EXPORT TextAction final : Action {
   std::string& targetText;  // Reference to the text being modified
   std::string beforeState;  // State of the text before the modification
   std::string afterState;   // State of the text after the modification
+  NodeID node = static_cast<NodeID>(UINT32_MAX);  // Owner of the text - assigned when the action is added
+  uint32_t prefix = 0;  // Unchanged characters before the edit - only with isDelta
+  uint32_t suffix = 0;  // Unchanged characters after the edit - only with isDelta
+  bool isDelta = false;  // Before and after only hold the changed part
 
   TextAction(std::string& target, std::string before)
       : Action(TEXT_EDIT), targetText(target), beforeState(std::move(before)) {}
   void setAfter(std::string after) { afterState = std::move(after); }
   void undo(EditorContext& ec) override;
   void redo(EditorContext& ec) override;
+  [[nodiscard]] size_t getMemory() const override;
+  // Strips the common prefix and suffix of both states - called once the edit is finished
+  void compact();
 };
 
-struct NodeDeleteAction final : Action {
+struct EXPORT NodeDeleteAction final : Action {
   std::vector<Node*> deletedNodes;
   std::vector<Connection*> deletedConnections;
   explicit NodeDeleteAction(EditorContext& ec, const std::unordered_map<NodeID, Node*>& selectedNodes);
   ~NodeDeleteAction() noexcept override;
   void undo(EditorContext& ec) override;
   void redo(EditorContext& ec) override;
+  [[nodiscard]] size_t getMemory() const override;
+  // Owned nodes are freed with the action
+  [[nodiscard]] bool ownsNodes() const { return hasOwnerShip; }
+  // Serializes the owned nodes and connections into a compressed buffer and frees them - undo restores them
+  void compact();
+  [[nodiscard]] bool isCompact() const { return !packed.empty(); }
 
  private:
+  std::vector<uint8_t> packed;             // Compressed nodes and connections
+  std::vector<std::string> packedStrings;  // String table of the packed data
   bool hasOwnerShip = true;
+  void restore(EditorContext& ec);
 };
 
-struct NodeCreateAction final : Action {
+struct EXPORT NodeCreateAction final : Action {
   std::vector<Node*> createdNodes;
   std::vector<Connection*> createdConnection;
   explicit NodeCreateAction(int size);
   ~NodeCreateAction() noexcept override;
   void undo(EditorContext& ec) override;
   void redo(EditorContext& ec) override;
+  [[nodiscard]] size_t getMemory() const override;
+  // Owned nodes are freed with the action
+  [[nodiscard]] bool ownsNodes() const { return hasOwnerShip; }
 
  private:
   bool hasOwnerShip = false;
 };
 
 //Saves the move delta
-struct NodeMovedAction final : Action {
+struct EXPORT NodeMovedAction final : Action {
   std::vector<std::pair<NodeID, Vector2>> movedNodes;
   explicit NodeMovedAction(int size);
   void undo(EditorContext& ec) override;
   void redo(EditorContext& ec) override;
+  [[nodiscard]] size_t getMemory() const override;
   float calculateDeltas(EditorContext& ec);
 };
 
-struct ConnectionDeleteAction final : Action {
+struct EXPORT ConnectionDeleteAction final : Action {
   std::vector<Connection*> deletedConnections;
   explicit ConnectionDeleteAction(int size);
   ~ConnectionDeleteAction() noexcept override;
   void undo(EditorContext& ec) override;
   void redo(EditorContext& ec) override;
+  [[nodiscard]] size_t getMemory() const override;
 
  private:
   bool hasOwnerShip = true;
 };
 
-struct ConnectionCreateAction final : Action {
+struct EXPORT ConnectionCreateAction final : Action {
   std::vector<Connection*> createdConnections;
   explicit ConnectionCreateAction(int size);
   ~ConnectionCreateAction() noexcept override;
   void undo(EditorContext& ec) override;
   void redo(EditorContext& ec) override;
+  [[nodiscard]] size_t getMemory() const override;
 
  private:
   bool hasOwnerShip = false;
@@ -20,13 +20,68 @@
 
 #include <cfloat>
 
+#include "application/EditorContext.h"
 #include "blocks/Connection.h"
 #include "blocks/Pin.h"
+#include "shared/BinaryIO.h"
 #include <raylib.h>
 
+void ConnectionData::save(BinaryWriter& writer) const {
+  //Output
+  writer.writeVarint(static_cast<uint32_t>(fromNode));
+  writer.writeInt(from);
+  writer.writeInt(out);
+  //Input
+  writer.writeVarint(static_cast<uint32_t>(toNode));
+  writer.writeInt(to);
+  writer.writeInt(in);
+}
+void ConnectionData::load(BinaryReader& reader) {
+  //Output
+  fromNode = static_cast<int>(reader.readVarint());
+  from = static_cast<int>(reader.readInt());
+  out = static_cast<int>(reader.readInt());
+  //Input
+  toNode = static_cast<int>(reader.readVarint());
+  to = static_cast<int>(reader.readInt());
+  in = static_cast<int>(reader.readInt());
+}
+
 Connection::Connection(Node& fromNode, Component* from, OutputPin& out, Node& toNode, Component* to, InputPin& in)
     : fromNode(fromNode), from(from), out(out), toNode(toNode), to(to), in(in) {}
 
+Connection* Connection::Create(EditorContext& ec, const ConnectionData& data) {
+  Node* fromNode = ec.core.getNode(static_cast<NodeID>(data.fromNode));
+  Node* toNode = ec.core.getNode(static_cast<NodeID>(data.toNode));
+  if (fromNode == nullptr || toNode == nullptr) return nullptr;
+
+  // We use int8_t as size_type to save space
+  Component* from = nullptr;
+  OutputPin* out;
+  if (data.from == -1) {
+    if (data.out < 0 || data.out >= fromNode->outputs.size()) return nullptr;
+    out = &fromNode->outputs[static_cast<int8_t>(data.out)];
+  } else {
+    if (data.from < 0 || data.from >= fromNode->components.size()) return nullptr;
+    from = fromNode->components[static_cast<int8_t>(data.from)];
+    if (data.out < 0 || data.out >= from->outputs.size()) return nullptr;
+    out = &from->outputs[static_cast<int8_t>(data.out)];
+  }
+
+  Component* to = nullptr;
+  InputPin* in;
+  if (data.to == -1) {
+    if (data.in != 0) return nullptr;
+    in = &toNode->nodeIn;
+  } else {
+    if (data.to < 0 || data.to >= toNode->components.size()) return nullptr;
+    to = toNode->components[static_cast<int8_t>(data.to)];
+    if (data.in < 0 || data.in >= to->inputs.size()) return nullptr;
+    in = &to->inputs[static_cast<int8_t>(data.in)];
+  }
+  return new Connection(*fromNode, from, *out, *toNode, to, *in);
+}
+
 Vector2 Connection::getFromPos() const {
   return {out.xPos, out.yPos};
 }
@@ -47,11 +102,32 @@ Color Connection::getConnectionColor() const {
 bool Connection::isVisible() const {
   return out.xPos != FLT_MIN;
 }
+ConnectionData Connection::getData() const {
+  return {static_cast<int>(fromNode.uID), fromNode.getComponentIndex(from), fromNode.getPinIndex(from, out),
+          static_cast<int>(toNode.uID),   toNode.getComponentIndex(to),     toNode.getPinIndex(to, in)};
+}
 
-void Connection::close() const {
+void Connection::close() {
   in.connection = nullptr;
+  in.isDirty = true;
+
+  // Unlink from the output pin
+  for (auto** it = &out.connections; *it != nullptr; it = &(*it)->nextOut) {
+    if (*it == this) {
+      *it = nextOut;
+      break;
+    }
+  }
+  nextOut = nullptr;
 }
 
 void Connection::open() {
   in.connection = this;
+  in.isDirty = true;
+
+  for (const auto* conn = out.connections; conn != nullptr; conn = conn->nextOut) {
+    if (conn == this) return;  // Already linked
+  }
+  nextOut = out.connections;
+  out.connections = this;
 }
\ No newline at end of file
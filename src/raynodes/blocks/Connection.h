@@ -23,6 +23,23 @@
 
 #include "shared/fwd.h"
 
+#include "blocks/ObjectPool.h"
+
+// How connections are saved - node ids plus component and pin indices (component -1 for node pins)
+struct ConnectionData {
+  int fromNode, from, out;
+  int toNode, to, in;
+  // Binary project format - symmetric
+  void save(BinaryWriter& writer) const;
+  void load(BinaryReader& reader);
+};
+
+// Weak reference to a connection - resolves to nullptr once the connection is removed
+struct ConnectionHandle {
+  uint32_t slot = UINT32_MAX;
+  uint32_t generation = 0;
+};
+
 struct EXPORT Connection final {
   //Source
   Node& fromNode;
@@ -32,12 +49,19 @@ struct EXPORT Connection final {
   Node& toNode;  // NULL when connection from node to node
   Component* to;
   InputPin& in;
+  Connection* nextOut = nullptr;  // Next connection from the same output pin
+  uint32_t slot = UINT32_MAX;     // Storage slot inside the core - UINT32_MAX when not added
   Connection(Node& fromNode, Component* from, OutputPin& out, Node& toNode, Component* to, InputPin& in);
+  // Resolves the pins by id and index - nullptr if a node, component or pin doesn't exist
+  static Connection* Create(EditorContext& ec, const ConnectionData& data);
+  static void* operator new(const size_t size) { return ObjectPool::Allocate(size); }
+  static void operator delete(void* ptr, const size_t size) { ObjectPool::Free(ptr, size); }
   [[nodiscard]] Vector2 getFromPos() const;
   [[nodiscard]] Vector2 getToPos() const;
   [[nodiscard]] Color getConnectionColor() const;
   [[nodiscard]] bool isVisible() const;
-  void close() const;
+  [[nodiscard]] ConnectionData getData() const;
+  void close();
   void open();
 };
 
@@ -35,6 +35,7 @@ void HandleDrag(EditorContext& ec, NodeGroup& ng) {
     for (const auto n : ng.nodes) {
       n->x -= delta.x;
       n->y -= delta.y;
+      ec.core.grid.update(*n);
     }
 
     ec.input.consumeMouse();
@@ -193,30 +194,14 @@ void NodeGroup::draw(EditorContext& ec) {
 
 void NodeGroup::update(EditorContext& ec) {
   const auto pressed = ec.input.isMBPressed(MOUSE_BUTTON_LEFT);
-
+  // Grouped nodes are evaluated with all others in dependency order - only input is handled here
   if (expanded) {
-    // Update the node normally
     for (const auto node : nodes) {
       node->isInGroup = false;
-      Node::Update(ec, *node);
+      Node::Update(ec, *node, false);
       node->isInGroup = true;
     }
   } else {
-    // Only update the pins and call update functions
-    for (const auto node : nodes) {
-      for (auto* comp : node->components) {
-        const float x = comp->x;
-        comp->x = FLT_MAX;
-        comp->update(ec, *node);
-        comp->x = x;
-      }
-      // Node update after
-      const float x = node->x;
-      node->x = FLT_MAX;
-      node->update(ec);
-      node->x = x;
-    }
-
     // Update used pins
     if (pressed) {
       const auto inX = pos.x;
@@ -230,7 +215,7 @@ void NodeGroup::update(EditorContext& ec) {
       }
     }
   }
-  HandleDrag(ec, *this);
+  if (!ec.persist.isLoading()) HandleDrag(ec, *this);
 }
 
 void NodeGroup::addNode(EditorContext& ec, Node& node) {
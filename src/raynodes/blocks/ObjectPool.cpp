@@ -0,0 +1,101 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "blocks/ObjectPool.h"
+
+#include <new>
+
+namespace {
+// Plain data only - stays valid during static destruction
+struct FreeSlot {
+  FreeSlot* next;
+};
+struct Chunk {
+  Chunk* next;
+  alignas(ObjectPool::ALIGNMENT) unsigned char data[1];
+};
+struct SizeClass {
+  FreeSlot* freeList;
+  Chunk* chunks;
+  size_t live;
+};
+
+constexpr size_t CLASS_COUNT = ObjectPool::MAX_SIZE / ObjectPool::ALIGNMENT;
+SizeClass CLASSES[CLASS_COUNT];
+
+size_t GetClass(const size_t size) {
+  return (size + ObjectPool::ALIGNMENT - 1) / ObjectPool::ALIGNMENT - 1;
+}
+
+void AddChunk(SizeClass& sc, const size_t slotSize) {
+  auto* chunk = static_cast<Chunk*>(::operator new(ObjectPool::CHUNK_SIZE));
+  chunk->next = sc.chunks;
+  sc.chunks = chunk;
+
+  // Thread the slots back to front so allocations walk the chunk forwards
+  const size_t count = (ObjectPool::CHUNK_SIZE - offsetof(Chunk, data)) / slotSize;
+  for (size_t i = count; i > 0; --i) {
+    auto* slot = reinterpret_cast<FreeSlot*>(chunk->data + (i - 1) * slotSize);
+    slot->next = sc.freeList;
+    sc.freeList = slot;
+  }
+}
+}  // namespace
+
+void* ObjectPool::Allocate(const size_t size) {
+  if (size > MAX_SIZE) [[unlikely]] { return ::operator new(size); }
+  auto& sc = CLASSES[GetClass(size)];
+  if (sc.freeList == nullptr) [[unlikely]] { AddChunk(sc, (GetClass(size) + 1) * ALIGNMENT); }
+
+  FreeSlot* slot = sc.freeList;
+  sc.freeList = slot->next;
+  ++sc.live;
+  return slot;
+}
+
+void ObjectPool::Free(void* ptr, const size_t size) {
+  if (ptr == nullptr) return;
+  if (size > MAX_SIZE) [[unlikely]] { return ::operator delete(ptr); }
+  auto& sc = CLASSES[GetClass(size)];
+  auto* slot = static_cast<FreeSlot*>(ptr);
+  slot->next = sc.freeList;
+  sc.freeList = slot;
+  --sc.live;
+}
+
+void ObjectPool::Release() {
+  for (auto& sc : CLASSES) {
+    if (sc.live != 0) continue;
+    while (sc.chunks != nullptr) {
+      Chunk* next = sc.chunks->next;
+      ::operator delete(sc.chunks);
+      sc.chunks = next;
+    }
+    sc.freeList = nullptr;
+  }
+}
+
+size_t ObjectPool::GetLiveCount() {
+  size_t count = 0;
+  for (const auto& sc : CLASSES) {
+    count += sc.live;
+  }
+  return count;
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RAYNODES_SRC_BLOCKS_OBJECTPOOL_H_
+#define RAYNODES_SRC_BLOCKS_OBJECTPOOL_H_
+
+#include "shared/fwd.h"
+
+#include <cstddef>
+
+// Pool for the many small editor objects - nodes, components and connections
+// Every 16 byte size class has its own free list fed from big chunks - so objects of the same type are close together
+// Only use from the main thread
+struct EXPORT ObjectPool final {
+  static constexpr size_t ALIGNMENT = 16;
+  static constexpr size_t MAX_SIZE = 1024;  // Bigger objects use the global allocator
+  static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+  static void* Allocate(size_t size);
+  static void Free(void* ptr, size_t size);
+  // Returns the chunks of all size classes without live objects in one go
+  static void Release();
+  // Currently allocated objects across all size classes
+  static size_t GetLiveCount();
+};
+
+#endif  //RAYNODES_SRC_BLOCKS_OBJECTPOOL_H_
@@ -81,13 +81,13 @@ bool Pin::UpdatePin(EditorContext& ec, Node& n, Component* c, Pin& p, const floa
   return false;
 }
 
-auto OutputPin::isConnectable(const EditorContext& ec, const InputPin& other) const -> bool {
+auto OutputPin::isConnectable(const EditorContext& /**/, const InputPin& other) const -> bool {
   if (other.pinType != pinType) [[unlikely]] { return false; }
 
   if (pinType == NODE) [[unlikely]] {
     // Have to check if the connection already exists - we allow multiple node-to-node inputs
-    for (const auto n : ec.core.connections) {
-      if (&n->out == this && &n->in == &other) return false;
+    for (const auto* conn = connections; conn != nullptr; conn = conn->nextOut) {
+      if (&conn->in == &other) return false;
     }
     return true;
   }
@@ -22,6 +22,9 @@
 #define RAYNODES_SRC_NODE_PIN_H_
 
 #include "shared/fwd.h"
+
+#include <cstring>
+
 #include "blocks/Connection.h"
 
 enum PinType : uint8_t {
@@ -147,16 +150,17 @@ struct Pin {
 
 struct OutputPin final : Pin {
   OutputData data{nullptr};
+  Connection* connections = nullptr;  // Outgoing connections - linked through Connection::nextOut
   explicit OutputPin(const PinType pt) : Pin{pt, OUTPUT, 0} {}
   [[nodiscard]] bool isConnectable(const EditorContext& ec, const InputPin& other) const;
+  // Marks all connected inputs dirty when the value changed
   template <PinType pt>
-  void setData(auto val) {
-    data.set<pt>(val);
-  }
+  void setData(auto val);
 };
 
 struct InputPin final : Pin {
   Connection* connection = nullptr;
+  bool isDirty = true;  // Set when the connected output changed
   explicit InputPin(const PinType pt) : Pin{pt, INPUT, 0} {}
   template <PinType pt>
   [[nodiscard]] auto getData() const {
@@ -184,4 +188,19 @@ struct InputPin final : Pin {
   [[nodiscard]] bool isConnected() const { return connection != nullptr; }
 };
 
+template <PinType pt>
+void OutputPin::setData(auto val) {
+  const OutputData previous = data;
+  data.set<pt>(val);
+
+  // Pointed to content can change without the pointer changing
+  if constexpr (pt != STRING && pt != DATA && pt != IMAGE) {
+    if (std::memcmp(&previous, &data, sizeof(OutputData)) == 0) [[likely]] { return; }
+  }
+
+  for (const auto* conn = connections; conn != nullptr; conn = conn->nextOut) {
+    conn->in.isDirty = true;
+  }
+}
+
 #endif  //RAYNODES_SRC_NODE_PIN_H_
\ No newline at end of file
@@ -0,0 +1,121 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "blocks/SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "blocks/Pin.h"
+#include "node/Node.h"
+
+namespace {
+uint64_t GetKey(const int x, const int y) {
+  return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(y);
+}
+int GetCell(const float val) {
+  return static_cast<int>(std::floor(val / SpatialGrid::CELL_SIZE));
+}
+SpatialGrid::CellRange GetRange(const Rectangle r) {
+  return {GetCell(r.x), GetCell(r.y), GetCell(r.x + r.width), GetCell(r.y + r.height)};
+}
+void AddEntries(SpatialGrid& grid, Node& node, const SpatialGrid::CellRange range) {
+  for (int x = range.x1; x <= range.x2; ++x) {
+    for (int y = range.y1; y <= range.y2; ++y) {
+      grid.cells[GetKey(x, y)].push_back({&node, range});
+    }
+  }
+}
+void RemoveEntries(SpatialGrid& grid, const Node& node, const SpatialGrid::CellRange range) {
+  for (int x = range.x1; x <= range.x2; ++x) {
+    for (int y = range.y1; y <= range.y2; ++y) {
+      const auto it = grid.cells.find(GetKey(x, y));
+      if (it == grid.cells.end()) [[unlikely]] { continue; }
+      auto& entries = it->second;
+      for (auto& entry : entries) {
+        if (entry.node == &node) {
+          entry = entries.back();  // Order inside a cell doesn't matter
+          entries.pop_back();
+          break;
+        }
+      }
+      if (entries.empty()) grid.cells.erase(it);
+    }
+  }
+}
+}  // namespace
+
+void SpatialGrid::insert(Node& node) {
+  if (ranges.contains(&node)) return;
+  const auto range = GetRange(node.getExtendedBounds(Pin::PIN_SIZE));
+  ranges.insert({&node, range});
+  AddEntries(*this, node, range);
+}
+
+void SpatialGrid::remove(const Node& node) {
+  const auto it = ranges.find(&node);
+  if (it == ranges.end()) return;
+  RemoveEntries(*this, node, it->second);
+  ranges.erase(it);
+}
+
+void SpatialGrid::update(Node& node) {
+  const auto it = ranges.find(&node);
+  if (it == ranges.end()) [[unlikely]] { return; }
+  const auto range = GetRange(node.getExtendedBounds(Pin::PIN_SIZE));
+  if (range == it->second) [[likely]] { return; }
+  RemoveEntries(*this, node, it->second);
+  AddEntries(*this, node, range);
+  it->second = range;
+}
+
+void SpatialGrid::clear() {
+  cells.clear();
+  ranges.clear();
+}
+
+void SpatialGrid::query(const Rectangle rect, std::vector<Node*>& out) const {
+  const auto [qx1, qy1, qx2, qy2] = GetRange(rect);
+  // Only report a node in the first cell it shares with the query
+  const auto collect = [&](const int x, const int y, const std::vector<Entry>& entries) {
+    for (const auto [node, range] : entries) {
+      if (x == std::max(range.x1, qx1) && y == std::max(range.y1, qy1)) out.push_back(node);
+    }
+  };
+
+  // Large queries (zoomed out) are cheaper by walking the occupied cells
+  const auto queryCells = static_cast<int64_t>(qx2 - qx1 + 1) * (qy2 - qy1 + 1);
+  if (queryCells > static_cast<int64_t>(cells.size())) [[unlikely]] {
+    for (const auto& [key, entries] : cells) {
+      const auto x = static_cast<int>(static_cast<uint32_t>(key >> 32));
+      const auto y = static_cast<int>(static_cast<uint32_t>(key));
+      if (x < qx1 || x > qx2 || y < qy1 || y > qy2) continue;
+      collect(x, y, entries);
+    }
+    return;
+  }
+
+  for (int x = qx1; x <= qx2; ++x) {
+    for (int y = qy1; y <= qy2; ++y) {
+      const auto it = cells.find(GetKey(x, y));
+      if (it != cells.end()) collect(x, y, it->second);
+    }
+  }
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RAYNODES_SRC_BLOCKS_SPATIALGRID_H_
+#define RAYNODES_SRC_BLOCKS_SPATIALGRID_H_
+
+#include "shared/fwd.h"
+
+#include <raylib.h>
+
+#pragma warning(push)
+#pragma warning(disable : 4251)  // Remove export warning
+
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid over the node bounds - nodes are registered in every cell they overlap
+// Bounds are extended by the pin size as pins are drawn outside the node
+struct EXPORT SpatialGrid final {
+  static constexpr float CELL_SIZE = 256.0F;
+
+  struct CellRange {
+    int x1, y1, x2, y2;
+    bool operator==(const CellRange& other) const = default;
+  };
+  struct Entry {
+    Node* node;
+    CellRange range;  // Stored with the entry so queries don't need a lookup
+  };
+
+  std::unordered_map<uint64_t, std::vector<Entry>> cells;
+  std::unordered_map<const Node*, CellRange> ranges;
+
+  void insert(Node& node);
+  void remove(const Node& node);
+  // Cheap when the node stays within its cells - call after moving or resizing a node
+  void update(Node& node);
+  void clear();
+  [[nodiscard]] bool contains(const Node& node) const { return ranges.contains(&node); }
+  // Appends all nodes whose cells overlap the rect - each node only once
+  // Results are candidates - exact bounds still need to be checked
+  void query(Rectangle rect, std::vector<Node*>& out) const;
+  void query(Vector2 point, std::vector<Node*>& out) const { query(Rectangle{point.x, point.y, 0, 0}, out); }
+};
+
+#pragma warning(pop)
+
+#endif  //RAYNODES_SRC_BLOCKS_SPATIALGRID_H_
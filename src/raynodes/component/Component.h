@@ -26,6 +26,8 @@
 #include <cxstructs/StackVector.h>
 
 #include "blocks/Pin.h"
+#include "shared/ByteReader.h"
+#include "shared/BinaryIO.h"
 
 #pragma warning(push)
 #pragma warning(disable : 4100)  // unreferenced formal parameter
@@ -60,24 +62,44 @@ struct EXPORT Component {                                            // Ordered
   bool isFocused = false;                                            // Internal state (don't change, only read)
   bool isHovered = false;                                            // Internal state (don't change, only read)
   bool internalLabel = false;                                        // Label drawn by the node or not
+  bool isSource = false;                                             // Updated every tick (user input, time...)
+  bool isDirty = true;                                               // Forces the next update
   const char* const label;                                           // Display name (and access name)
   const char* const id;                                              // Uniquely identifying id (allocated ptr)
 
   explicit Component(const ComponentTemplate ct, uint16_t w = 0, uint16_t h = 0)
       : width(w), height(h), label(ct.label), id(ct.component) {}
   virtual ~Component() = default;
+  // All components are allocated from the editor pool - no over-aligned members
+  static void* operator new(const size_t size) { return ObjectPool::Allocate(size); }
+  static void operator delete(void* ptr, const size_t size) { ObjectPool::Free(ptr, size); }
 
   //-----------CORE-----------//
   // Necessary to copy the component
   virtual Component* clone() = 0;
   // IMPORTANT: Only called when its bounds are visible on the screen!
   virtual void draw(EditorContext& ec, Node& parent) = 0;
-  // Guaranteed to be called once per tick (on the main thread) (not just when focused)
+  // Called once per tick (on the main thread) when an input changed, the component is hovered/focused
+  // or when it's a source - write outputs with setData() so changes propagate downstream
   virtual void update(EditorContext& ec, Node& parent) = 0;
   // Use the symmetric helpers : io_save(file,myFloat)...
   virtual void save(FILE* file) {}
   //Use the symmetric helpers : io_load(file,myFloat)...
   virtual void load(FILE* file) {}
+  // Used when opening projects - same helpers: io_load(reader,myFloat)...
+  // Falls back to load(FILE*) so components only implementing that still work
+  virtual void load(ByteReader& reader) {
+    load(reader.getFile());
+    reader.syncFromFile();
+  }
+  // Used for binary projects (.rnb) - symmetric: writer.writeFloat(myFloat) -> reader.readFloat()
+  // Both fall back to the text functions above - their output is stored as a blob
+  virtual void save(BinaryWriter& writer) {
+    writer.writeText([this](FILE* file) { save(file); });
+  }
+  virtual void load(BinaryReader& reader) {
+    reader.readText([this](FILE* file) { load(file); });
+  }
 
   //-----------EVENTS-----------//
   // All called once, guaranteed before update() is called
@@ -126,6 +148,27 @@ struct EXPORT Component {                                            // Ordered
   virtual void* getData() { return nullptr; }
   virtual bool getBool() { return false; }
 
+  // Evaluation
+  [[nodiscard]] bool needsUpdate() {
+    if (isSource || isDirty || isFocused || isHovered) return true;
+    for (auto& in : inputs) {
+      if (in.isDirty) return true;
+    }
+    return false;
+  }
+  void clearDirty() {
+    isDirty = false;
+    for (auto& in : inputs) {
+      in.isDirty = false;
+    }
+  }
+  // Cleared before so changes made during the update (feedback loops) are kept for the next tick
+  void evaluate(EditorContext& ec, Node& parent) {
+    if (!needsUpdate()) return;
+    clearDirty();
+    update(ec, parent);
+  }
+
   // Getters
   [[nodiscard]] const char* getLabel() const { return label; }
   [[nodiscard]] float getWidth() const { return width; }
@@ -78,21 +78,16 @@ void CheckPinCollisions(EditorContext& ec, Node& n, Component* c) {
   }
 }
 
-void UpdateComponent(EditorContext& ec, Node& n, Component* c) {
-  const auto compRect = c->getBounds();
+void UpdateComponent(EditorContext& ec, Node& n, Component* c, const bool nearMouse) {
   const auto worldMouse = ec.logic.worldMouse;
   const auto pressed = ec.input.isMBPressed(MOUSE_BUTTON_LEFT);
 
   //Pins are partly outside so need to check them regardless of hover state
-  if (pressed) {
-    //First check if the mouse is close to the rect and mouse is pressed
-    //TODO this check is done for all components / only needs to be done once
-    if (CheckCollisionPointRec(worldMouse, n.getExtendedBounds(Pin::PIN_SIZE))) { CheckPinCollisions(ec, n, c); }
-  }
+  if (pressed && nearMouse) { CheckPinCollisions(ec, n, c); }
 
   //Mouse Enter
   const bool previousHovered = c->isHovered;
-  const auto compHovered = CheckCollisionPointRec(worldMouse, compRect);
+  const auto compHovered = nearMouse && CheckCollisionPointRec(worldMouse, c->getBounds());
   c->isHovered = compHovered;
 
   if (previousHovered != compHovered) {
@@ -110,11 +105,15 @@ void UpdateComponent(EditorContext& ec, Node& n, Component* c) {
   }
 
   if (previousFocused != c->isFocused) {
+    ec.logic.focusNode = &n;
     if (c->isFocused) c->onFocusGain(ec);
     else c->onFocusLoss(ec);
+    ec.logic.focusNode = nullptr;
+    c->isDirty = true;
   }
 
-  c->update(ec, n);
+  // Focused components handle their input every frame - everything else waits for the next tick
+  if (c->isFocused) c->evaluate(ec, n);
 
   //Consume input after update
   if (c->isFocused) {
@@ -123,19 +122,6 @@ void UpdateComponent(EditorContext& ec, Node& n, Component* c) {
   }
 }
 
-//selectedNodes is std::unordered_map
-void HandleSelection(Node& n, EditorContext& ec, const Rectangle bounds, auto& selectedNodes) {
-  if (CheckCollisionRecs(bounds, ec.logic.selectRect)) {
-    selectedNodes.insert({n.uID, &n});
-    n.isHovered = true;
-    ec.logic.isAnyNodeHovered = true;
-    ec.logic.hoveredNode = &n;
-  } else {
-    selectedNodes.erase(n.uID);
-    n.isHovered = false;
-  }
-}
-
 //selectedNodes is std::unordered_map
 void HandleHover(EditorContext& ec, Node& n, std::unordered_map<NodeID, Node*>& selectedNodes) {
   if (ec.input.isMBPressed(MOUSE_BUTTON_LEFT)) {
@@ -166,6 +152,7 @@ void HandleDrag(Node& n, EditorContext& ec, auto& selectedNodes, auto worldMouse
     const Vector2 movementDelta = {worldMouse.x - DRAG_OFFSET.x, worldMouse.y - DRAG_OFFSET.y};
     n.x += movementDelta.x;
     n.y += movementDelta.y;
+    ec.core.grid.update(n);
 
     //Update selected nodes
     if (!selectedNodes.empty()) {
@@ -175,6 +162,7 @@ void HandleDrag(Node& n, EditorContext& ec, auto& selectedNodes, auto worldMouse
           // Apply the same movement to all selected nodes
           node->x += movementDelta.x;
           node->y += movementDelta.y;
+          ec.core.grid.update(*node);
         }
       }
     }
@@ -249,6 +237,10 @@ Node::Node(const Node& n, const NodeID id)
     for (auto& in : clone->inputs) {
       in.connection = nullptr;  //Dont copy the connection ptr
     }
+    for (auto& out : clone->outputs) {
+      out.connections = nullptr;
+    }
+    clone->isDirty = true;
     components.push_back(clone);
   }
   outputs.push_back(OutputPin{NODE});
@@ -293,10 +285,11 @@ void Node::Draw(EditorContext& ec, Node& n) {
 
   n.contentHeight = static_cast<uint16_t>(startY - initialY);
   n.height = std::max(startY - n.y + Pin::PIN_SIZE + PADDING, MIN_HEIGHT);
+  ec.core.grid.update(n);
 
   n.draw(ec);  // Call event func last
 }
-void Node::Update(EditorContext& ec, Node& n) {
+void Node::Update(EditorContext& ec, Node& n, const bool simulate) {
   if (n.isInGroup) [[unlikely]] { return; }
 
   //Cache
@@ -304,23 +297,39 @@ void Node::Update(EditorContext& ec, Node& n) {
   const auto worldMouse = ec.logic.worldMouse;
   auto& selectedNodes = ec.core.selectedNodes;
 
+  // Nodes outside the grid (e.g. the node creator preview) are always checked
+  const bool nearMouse = n.isDragged || !ec.core.grid.contains(n) || ec.logic.isNearMouse(n);
+
   // Update node-level pins
-  UpdateNodePins(ec, n);
+  if (nearMouse) UpdateNodePins(ec, n);
 
-  //Always update components to allow for continuous ones (not just when focused)
-  float biggestWidth = FLT_MIN;
   for (auto* c : n.components) {
-    UpdateComponent(ec, n, c);
+    UpdateComponent(ec, n, c, nearMouse);
+  }
+
+  if (simulate) Evaluate(ec, n);
+
+  float biggestWidth = FLT_MIN;
+  for (const auto* c : n.components) {
     if (c->getWidth() > biggestWidth) { biggestWidth = static_cast<float>(c->width); }
   }
 
   // Components are drawn with 2 * PADDING inset (both sides)
   n.width = std::max(biggestWidth + PADDING * 4.0F, MIN_WIDTH);
+  ec.core.grid.update(n);
 
-  n.update(ec);  // Call event func after components
+  //Nodes can't be selected or dragged while a project streams in
+  if (ec.persist.isLoading()) [[unlikely]] {
+    n.isHovered = false;
+    n.isDragged = false;
+    return;
+  }
 
-  //User is selecting -> no dragging
-  if (ec.logic.isSelecting) [[unlikely]] { return HandleSelection(n, ec, bounds, selectedNodes); }
+  //User is selecting -> no dragging - selected nodes are marked again afterwards
+  if (ec.logic.isSelecting) [[unlikely]] {
+    n.isHovered = false;
+    return;
+  }
 
   //Another node is dragged no point in updating this one
   if (!n.isDragged && ec.logic.isAnyNodeDragged) {
@@ -330,7 +339,7 @@ void Node::Update(EditorContext& ec, Node& n) {
   }
 
   //Check if hovered
-  if (n.isDragged || CheckCollisionPointRec(worldMouse, bounds)) [[unlikely]] {
+  if (n.isDragged || (nearMouse && CheckCollisionPointRec(worldMouse, bounds))) [[unlikely]] {
     ec.logic.hoveredNode = &n;
     n.isHovered = true;
     //Its hovered - what's going to happen?
@@ -345,8 +354,15 @@ void Node::Update(EditorContext& ec, Node& n) {
   //Node is dragged
   if (n.isDragged) [[unlikely]] { HandleDrag(n, ec, selectedNodes, worldMouse); }
 }
+void Node::Evaluate(EditorContext& ec, Node& n) {
+  //Always update components to allow for continuous ones - focused ones already handled their input
+  for (auto* c : n.components) {
+    if (!c->isFocused) c->evaluate(ec, n);
+  }
+  n.update(ec);  // Call event func after components
+}
 void Node::SaveState(FILE* file, const Node& n) {
-  cxstructs::io_save(file, n.uID);
+  cxstructs::io_save(file, static_cast<int>(n.uID));
 
   // Save components first for faster access time when importing
   for (const auto c : n.components) {
@@ -375,6 +391,55 @@ void Node::LoadState(FILE* file, Node& n) {
   cxstructs::io_load(file, n.y);
 }
 
+void Node::LoadState(ByteReader& reader, Node& n) {
+  for (const auto c : n.components) {
+    c->load(reader);
+    if (!reader.isEOF()) ++reader.cursor;  // Skip the component end marker
+  }
+
+  // Custom node state is only available through the FILE* interface
+  n.loadState(reader.getFile());
+  reader.syncFromFile();
+
+  cxstructs::io_load(reader, n.x);
+  cxstructs::io_load(reader, n.y);
+}
+
+void Node::SaveState(BinaryWriter& writer, const Node& n) {
+  writer.writeVarint(n.uID);
+
+  // Components are length prefixed - a component that reads too much or too little only affects itself
+  writer.writeVarint(n.components.size());
+  BinaryWriter component{writer.strings};
+  for (const auto c : n.components) {
+    component.clear();
+    c->save(component);
+    writer.writeBlob(component.data.data(), component.data.size());
+  }
+
+  writer.writeText([&n](FILE* file) { n.saveState(file); });
+
+  writer.writeFloat(n.x);
+  writer.writeFloat(n.y);
+}
+void Node::LoadState(BinaryReader& reader, Node& n) {
+  //Node name (type) was already parsed
+  //Node id was already parsed
+
+  const auto count = reader.readVarint();
+  for (uint64_t i = 0; i < count; ++i) {
+    BinaryReader component = reader.readBlob();
+    if (i < static_cast<uint64_t>(n.components.size())) n.components[static_cast<int8_t>(i)]->load(component);
+    // The following components still load - the caller decides what a damaged node means
+    if (component.failed) reader.failed = true;
+  }
+
+  reader.readText([&n](FILE* file) { n.loadState(file); });
+
+  n.x = reader.readFloat();
+  n.y = reader.readFloat();
+}
+
 // Components
 void Node::addComponent(Component* comp) {
   components.push_back(comp);
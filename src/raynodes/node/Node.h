@@ -51,6 +51,7 @@ struct Node {                                                             // Ord
   float width, height;                                                    // Dimensions
   Color4 color;                                                           // Header colour
   uint16_t contentHeight = 0;                                             //Current height of the content
+  uint32_t zIndex = 0;                                                    // Draw order - higher is on top
   const char* const name = nullptr;                                       //Unique allocated name
   bool isHovered = false;                                                 // If the node is hovered
   bool isDragged = false;                                                 // If the node is dragged
@@ -63,12 +64,21 @@ struct Node {                                                             // Ord
   explicit Node(const NodeTemplate& nt, Vec2 pos, NodeID id);
   Node(const Node& n, NodeID id);
   virtual ~Node();
+  // All nodes are allocated from the editor pool - no over-aligned members
+  static void* operator new(const size_t size) { return ObjectPool::Allocate(size); }
+  static void operator delete(void* ptr, const size_t size) { ObjectPool::Free(ptr, size); }
 
   // Internal functions
-  static void Update(EditorContext& ec, Node& n);
+  // Without simulate only input, hover and drag are handled - components evaluate only while focused
+  static void Update(EditorContext& ec, Node& n, bool simulate = true);
+  // One simulation step of the components that aren't focused and the node itself
+  static void Evaluate(EditorContext& ec, Node& n);
   static void Draw(EditorContext& ec, Node& n);
   static void SaveState(FILE* file, const Node& n);
   static void LoadState(FILE* file, Node& n);
+  static void LoadState(ByteReader& reader, Node& n);
+  static void SaveState(BinaryWriter& writer, const Node& n);
+  static void LoadState(BinaryReader& reader, Node& n);  // Sets failed if a component read past its data
 
   //-----------CORE-----------//
   [[nodiscard]] virtual Node* clone(NodeID nid);
@@ -0,0 +1,223 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RAYNODES_SRC_SHARED_BINARYIO_H_
+#define RAYNODES_SRC_SHARED_BINARYIO_H_
+
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Binary project format (.rnb)
+//  Header   : "RNB" + version byte, section count (u32)
+//  Table    : per section - id, offset from the file start, size (all u32)
+//  Sections : Strings first - everything else references strings by their index
+// Integers are LEB128 varints (signed ones zigzag encoded), floats raw little endian IEEE 754
+// Fixed width numbers are little endian regardless of the platform
+static constexpr char RNB_MAGIC[3] = {'R', 'N', 'B'};
+static constexpr uint8_t RNB_VERSION = 1;
+static constexpr int RNB_HEADER_SIZE = 8;
+static constexpr int RNB_SECTION_ENTRY_SIZE = 12;
+
+enum RnbSection : uint32_t {
+  RNB_STRINGS,
+  RNB_EDITOR_DATA,
+  RNB_TEMPLATES,
+  RNB_NODES,
+  RNB_CONNECTIONS,
+  RNB_GROUPS,
+  RNB_SECTION_COUNT  // Unknown sections are skipped when reading
+};
+
+// Every unique string is stored once per file
+struct StringTable final {
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> indices;
+
+  uint32_t add(const std::string& str) {
+    const auto [it, inserted] = indices.insert({str, static_cast<uint32_t>(strings.size())});
+    if (inserted) strings.push_back(str);
+    return it->second;
+  }
+  void clear() {
+    strings.clear();
+    indices.clear();
+  }
+};
+
+// Use the same order of calls in save() and load(): writer.writeFloat(myFloat) -> reader.readFloat()
+struct BinaryWriter final {
+  std::vector<uint8_t> data;
+  StringTable* strings = nullptr;  // Shared by all sections of a file
+
+  explicit BinaryWriter(StringTable* strings = nullptr) : strings(strings) {}
+
+  void clear() { data.clear(); }
+  void writeByte(const uint8_t b) { data.push_back(b); }
+  void writeBytes(const void* ptr, const size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(ptr);
+    data.insert(data.end(), bytes, bytes + size);
+  }
+  void writeU32(const uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+  }
+  void writeVarint(uint64_t value) {
+    while (value >= 0x80) {
+      data.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(value));
+  }
+  // Zigzag encoded - small negative numbers stay small
+  void writeInt(const int64_t value) {
+    writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+  void writeBool(const bool value) { data.push_back(value ? 1 : 0); }
+  void writeFloat(const float value) { writeU32(std::bit_cast<uint32_t>(value)); }
+  void writeString(const std::string& str) { writeVarint(strings->add(str)); }
+  void writeString(const char* str) { writeString(std::string(str == nullptr ? "" : str)); }
+  // Length prefixed bytes
+  void writeBlob(const void* ptr, const size_t size) {
+    writeVarint(size);
+    writeBytes(ptr, size);
+  }
+  // Stores whatever func writes with the text helpers (io_save) as a blob
+  template <typename Func>
+  void writeText(Func func) {
+#ifdef _WIN32
+    FILE* file = tmpfile();
+    if (file == nullptr) return writeVarint(0);
+    func(file);
+    const long size = ftell(file);
+    std::vector<uint8_t> text(size > 0 ? size : 0);
+    rewind(file);
+    const auto read = fread(text.data(), 1, text.size(), file);
+    fclose(file);
+    writeBlob(text.data(), read);
+#else
+    char* buffer = nullptr;
+    size_t size = 0;
+    FILE* file = open_memstream(&buffer, &size);
+    if (file == nullptr) return writeVarint(0);
+    func(file);
+    fclose(file);
+    writeBlob(buffer, size);
+    free(buffer);
+#endif
+  }
+};
+
+// Reading past the end sets failed and returns zero values - check once after loading
+struct BinaryReader final {
+  const uint8_t* cursor = nullptr;
+  const uint8_t* end = nullptr;
+  const std::vector<std::string_view>* strings = nullptr;  // Shared by all sections of a file
+  bool failed = false;
+
+  BinaryReader() = default;
+  BinaryReader(const void* ptr, const size_t size, const std::vector<std::string_view>* strings = nullptr)
+      : cursor(static_cast<const uint8_t*>(ptr)), end(cursor + size), strings(strings) {}
+
+  [[nodiscard]] bool isEOF() const { return cursor >= end; }
+  [[nodiscard]] size_t remaining() const { return static_cast<size_t>(end - cursor); }
+
+  uint8_t readByte() {
+    if (cursor >= end) [[unlikely]] {
+      failed = true;
+      return 0;
+    }
+    return *cursor++;
+  }
+  uint32_t readU32() {
+    if (remaining() < 4) [[unlikely]] {
+      failed = true;
+      cursor = end;
+      return 0;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+      value |= static_cast<uint32_t>(cursor[i]) << (i * 8);
+    }
+    cursor += 4;
+    return value;
+  }
+  uint64_t readVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const uint8_t b = readByte();
+      value |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if ((b & 0x80) == 0) return value;
+    }
+    failed = true;
+    return 0;
+  }
+  int64_t readInt() {
+    const uint64_t value = readVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+  bool readBool() { return readByte() == 1; }
+  float readFloat() { return std::bit_cast<float>(readU32()); }
+  std::string_view readString() {
+    const auto index = readVarint();
+    if (strings == nullptr || index >= strings->size()) [[unlikely]] {
+      failed = true;
+      return {};
+    }
+    return (*strings)[index];
+  }
+  // Returns a reader limited to the blob - the cursor is moved past it
+  BinaryReader readBlob() {
+    const auto size = readVarint();
+    if (size > remaining()) [[unlikely]] {
+      failed = true;
+      cursor = end;
+      return {};
+    }
+    BinaryReader blob{cursor, static_cast<size_t>(size), strings};
+    cursor += size;
+    return blob;
+  }
+  // Passes a blob written with writeText() to the text helpers (io_load)
+  template <typename Func>
+  void readText(Func func) {
+    const BinaryReader blob = readBlob();
+    if (blob.isEOF()) return;  // Nothing was written
+#ifdef _WIN32
+    FILE* file = tmpfile();
+    if (file == nullptr) return;
+    fwrite(blob.cursor, 1, blob.remaining(), file);
+    rewind(file);
+#else
+    FILE* file = fmemopen(const_cast<uint8_t*>(blob.cursor), blob.remaining(), "rb");
+    if (file == nullptr) return;
+#endif
+    func(file);
+    fclose(file);
+  }
+};
+
+#endif  //RAYNODES_SRC_SHARED_BINARYIO_H_
@@ -0,0 +1,195 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RAYNODES_SRC_SHARED_BYTEREADER_H_
+#define RAYNODES_SRC_SHARED_BYTEREADER_H_
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <cxutil/cxio.h>
+
+// Holds a whole file in memory and parses it with a cursor
+// Use the symmetric cxio helpers the same way as with a FILE*: io_load(reader, myFloat)
+// FILE* based loaders still work through getFile() - which only costs a seek when used
+struct ByteReader final {
+  std::vector<char> data;  // Null terminated - allows strtol & co. to stop at the end
+  const char* cursor = nullptr;
+  const char* end = nullptr;
+
+  ByteReader() = default;
+  ByteReader(const ByteReader&) = delete;
+  ByteReader& operator=(const ByteReader&) = delete;
+  ~ByteReader() {
+    if (file != nullptr) fclose(file);
+  }
+
+  // Reads the whole file with a single read
+  bool open(const char* path) {
+    FILE* in = fopen(path, "rb");
+    if (in == nullptr) return false;
+    fseek(in, 0, SEEK_END);
+    const long size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    if (size < 0) {
+      fclose(in);
+      return false;
+    }
+    data.resize(static_cast<size_t>(size) + 1);
+    const auto read = fread(data.data(), 1, static_cast<size_t>(size), in);
+    fclose(in);
+    data[read] = '\0';
+    cursor = data.data();
+    end = cursor + read;
+    return read == static_cast<size_t>(size);
+  }
+
+  [[nodiscard]] bool isEOF() const { return cursor >= end; }
+  [[nodiscard]] long getOffset() const { return static_cast<long>(cursor - data.data()); }
+
+  // Returns a stream positioned at the cursor - call syncFromFile() after reading from it
+  FILE* getFile() {
+    if (file == nullptr) [[unlikely]] {
+#ifdef _WIN32
+      file = tmpfile();
+      if (file != nullptr) fwrite(data.data(), 1, end - data.data(), file);
+#else
+      file = fmemopen(data.data(), end - data.data(), "rb");
+#endif
+    }
+    if (file != nullptr) fseek(file, getOffset(), SEEK_SET);
+    return file;
+  }
+  void syncFromFile() {
+    if (file == nullptr) return;
+    const long pos = ftell(file);
+    if (pos >= 0) cursor = std::min<const char*>(data.data() + pos, end);
+  }
+
+ private:
+  FILE* file = nullptr;
+};
+
+// Buffer overloads of the cxio loading helpers - same behaviour as the FILE* versions
+namespace cxstructs {
+static constexpr char IO_NEW_LINE_SUB = '\036';  // NEW_LINE_SUB of cxio - the macro is redefined by the editor
+
+inline void io_load_newline(ByteReader& r, const bool force = false) {
+  while (r.cursor < r.end) {
+    const char ch = *r.cursor++;
+    if (!force && ch == '\037') return;
+    if (ch == '\n') return;
+  }
+}
+inline void io_load_skip_separator(ByteReader& r) {
+  while (r.cursor < r.end) {
+    if (*r.cursor++ == '\037') return;
+  }
+}
+inline bool io_load_inside_section(ByteReader& r, const char* section) {
+  if (r.cursor >= r.end) return false;
+  if (*r.cursor != '-') return true;  // Still inside same section
+  if (r.cursor + 1 >= r.end || r.cursor[1] != '-') return true;
+
+  r.cursor += 2;
+  const char* name = r.cursor;
+  int count = 0;
+  const int sectionLength = static_cast<int>(strlen(section));
+  while (r.cursor < r.end && *r.cursor != '-' && count < sectionLength && count < MAX_SECTION_SIZE - 1) {
+    ++r.cursor;
+    ++count;
+  }
+  // The FILE* version consumes the character that ended the name
+  if (r.cursor < r.end) ++r.cursor;
+  const bool sameSection = strncmp(name, section, count) == 0;  // Same prefix semantics as the FILE* version
+  io_load_newline(r, false);
+  return sameSection;
+}
+// The end of the data also counts - avoids endless loops on truncated files
+inline bool io_load_is_newline(const ByteReader& r) {
+  return r.cursor >= r.end || *r.cursor == '\n';
+}
+inline void io_load(ByteReader& r, std::string& s) {
+  while (r.cursor < r.end) {
+    const char ch = *r.cursor++;
+    if (ch == '\037') return;
+    s.push_back(ch == IO_NEW_LINE_SUB ? '\n' : ch);
+  }
+}
+inline int io_load(ByteReader& r, char* buffer, const size_t buffer_size) {
+  int count = 0;
+  while (count < static_cast<int>(buffer_size) - 1 && r.cursor < r.end && *r.cursor != '\037') {
+    const char ch = *r.cursor++;
+    buffer[count++] = ch == IO_NEW_LINE_SUB ? '\n' : ch;
+  }
+  buffer[count] = '\0';
+  io_load_skip_separator(r);
+  return count;
+}
+namespace detail {
+// Mirrors fscanf - an optional literal after the value is consumed
+inline void io_skip_char(ByteReader& r, const char ch) {
+  if (r.cursor < r.end && *r.cursor == ch) ++r.cursor;
+}
+inline void io_parse(ByteReader& r, float& f) {
+  char* parsed;
+  const float val = strtof(r.cursor, &parsed);
+  if (parsed == r.cursor) return;
+  f = val;
+  r.cursor = parsed;
+}
+}  // namespace detail
+inline void io_load(ByteReader& r, int& i) {
+  char* parsed;
+  const long val = strtol(r.cursor, &parsed, 10);
+  if (parsed == r.cursor) return;
+  i = static_cast<int>(val);
+  r.cursor = parsed;
+  detail::io_skip_char(r, '\037');
+}
+inline void io_load(ByteReader& r, bool& value) {
+  int num = 0;
+  io_load(r, num);
+  value = num == 1;
+}
+inline void io_load(ByteReader& r, float& f) {
+  detail::io_parse(r, f);
+  detail::io_skip_char(r, '\037');
+}
+inline void io_load(ByteReader& r, float& f, float& f2, float& f3) {
+  detail::io_parse(r, f);
+  detail::io_skip_char(r, ';');
+  detail::io_parse(r, f2);
+  detail::io_skip_char(r, ';');
+  detail::io_parse(r, f3);
+  detail::io_skip_char(r, '\037');
+}
+inline void io_load(ByteReader& r, float& f, float& f2) {
+  detail::io_parse(r, f);
+  detail::io_skip_char(r, ';');
+  detail::io_parse(r, f2);
+  detail::io_skip_char(r, '\037');
+}
+}  // namespace cxstructs
+
+#endif  //RAYNODES_SRC_SHARED_BYTEREADER_H_
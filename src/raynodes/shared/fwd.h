@@ -27,7 +27,7 @@
 enum PinType : uint8_t;     // Datatype of connection pins
 enum MOperation : uint8_t;  // Type of math operation
 enum Direction : bool;      // Which directiont the pin is factin (in/out)
-enum NodeID : uint16_t;     // Unique NodeID counting up - Limits to 65536 nodes!
+enum NodeID : uint32_t;     // Unique NodeID counting up - UINT32_MAX is the sentinel value
 struct Connection;          // A connection between two components
 struct Component;           // Base class for all components
 struct Pin;                 // Base class for both pin types
@@ -48,6 +48,12 @@ class Window;               // UI class
 struct TextField;           // UI class
 struct Vec2;                // Vector2 replacement
 struct ComponentTemplate;   // Building plan for a component
+struct SpatialGrid;         // Uniform grid to find nodes by position
+struct ByteReader;          // Whole file in memory - parsed with a cursor
+struct BinaryWriter;        // Writes the binary project format
+struct BinaryReader;        // Reads the binary project format
+struct ProjectLoad;         // Project import spread over multiple ticks
+struct ProjectSnapshot;     // Copy of the project written by a background save
 
 using ComponentCreateFunc = Component* (*)(ComponentTemplate);        // Takes a name and returns a new Component
 using NodeCreateFunc = Node* (*)(const NodeTemplate&, Vec2, NodeID);  // Creates a new node
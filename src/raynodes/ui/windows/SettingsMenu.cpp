@@ -34,5 +34,12 @@ void SettingsMenu::drawContent(EditorContext& ec, const Rectangle& body) {
     UI::DrawText(ec, topLeft, "Here will be UI options");
   } else if (activeIndex == 1) {  // Updates
     UI::DrawText(ec, topLeft, "Here will be automatic updates");
+  } else if (activeIndex == 2) {  // Simulation
+    auto& tickRate = ec.core.tickRate;
+    UI::DrawText(ec, topLeft, ec.string.formatText("Simulation ticks per second: %d", static_cast<int>(tickRate)));
+    const Rectangle sliderBounds = {topLeft.x, topLeft.y + 25.0F, 300.0F, 20.0F};
+    if (GuiSliderBar(ec.display.getFullyScaled(sliderBounds), "1", "10000", &tickRate, 1.0F, 10000.0F)) {
+      ec.input.consumeMouse();
+    }
   }
 }
\ No newline at end of file
@@ -24,7 +24,8 @@
 #include "ui/Window.h"
 class SettingsMenu final : public Window {
   static constexpr auto* menuText = "#181#User Interface;"
-                                    "#222#Updates";
+                                    "#222#Updates;"
+                                    "#139#Simulation";
   int activeIndex = 0;
   int scrollIndex = 0;
 
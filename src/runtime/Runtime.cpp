@@ -0,0 +1,46 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Runtime.h"
+
+Runtime::Runtime() : context(0, nullptr) {
+  context.core.loadCore(context);
+}
+
+bool Runtime::loadPlugins(const char* directory) {
+  if (directory == nullptr) return context.plugin.loadPlugins(context);
+  return context.plugin.loadPlugins(context, directory);
+}
+
+bool Runtime::loadProject(const char* path) {
+  if (path == nullptr || *path == '\0') return false;  // Would open the file picker
+  context.persist.openedFilePath = path;
+  return context.persist.importProject(context);
+}
+
+void Runtime::step(const int ticks) {
+  auto& ec = context;
+  for (int i = 0; i < ticks; ++i) {
+    // There is no user - nothing should react to stale input
+    ec.input.consumeMouse();
+    ec.input.consumeKeyboard();
+    ec.core.simulateTick(ec);
+  }
+}
@@ -0,0 +1,45 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RAYNODES_SRC_RUNTIME_RUNTIME_H_
+#define RAYNODES_SRC_RUNTIME_RUNTIME_H_
+
+#include "application/EditorContext.h"
+
+// Headless counterpart to the NodeEditor - steps graphs without opening a window or creating a GPU context
+// Nodes are created through the same plugin registries as inside the editor
+// Components and plugins still use raylib types and draw calls, so raylib (and on Linux the X11/GL libraries
+// it links) has to be installed where the runtime runs - it is only loaded, never initialized
+class Runtime final {
+  EditorContext context;
+
+ public:
+  Runtime();
+  // Loads all plugins inside the directory - defaults to the plugin folder next to the executable
+  bool loadPlugins(const char* directory = nullptr);
+  bool loadProject(const char* path);
+  // Advances the graph by the given amount of ticks - each simulates 1 / Core::tickRate seconds
+  void step(int ticks = 1);
+
+  EditorContext& getContext() { return context; }
+  [[nodiscard]] uint64_t getTick() const { return context.core.simulationTick; }
+};
+
+#endif  //RAYNODES_SRC_RUNTIME_RUNTIME_H_
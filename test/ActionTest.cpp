@@ -1,6 +1,7 @@
 #include <catch_amalgamated.hpp>
 
 #include "TestUtil.h"
+#include "application/elements/Action.h"
 
 // This tests correct deletion of action
 // Preventing double deletions
@@ -50,4 +51,100 @@ TEST_CASE("Fuzzy Test", "[Actions]") {
   ec.core.resetEditor(ec);
 
   REQUIRE(ec.core.actionQueue.size() == 1);  // New canvas action
+}
+
+TEST_CASE("Test history memory budget", "[Actions]") {
+  auto ec = TestUtil::getBasicContext();
+  ec.core.resetEditor(ec);  // Adds the first dummy action
+  const auto historyBytes = [](const EditorContext& ec) {
+    size_t bytes = 0;
+    for (const auto* action : ec.core.actionQueue) {
+      bytes += action->getMemory();
+    }
+    return bytes;
+  };
+  const auto getText = [](Node* node) -> std::string& {
+    return node->getComponent<TextFieldC<>>("Text")->textField.buffer;
+  };
+
+  // Text edits only keep the changed part
+  auto* edited = ec.core.createAddNode(ec, "Text", {});
+  auto& buffer = getText(edited);
+  buffer = std::string(10000, 'a');
+  auto* edit = new TextAction(buffer, buffer);
+  buffer.insert(5000, "bc");
+  edit->setAfter(buffer);
+  ec.logic.focusNode = edited;  // Set by the node when its components lose focus
+  ec.core.addEditorAction(ec, edit);
+  ec.logic.focusNode = nullptr;
+  REQUIRE(edit->getMemory() < 1000);  // Instead of two copies of 10000 characters
+  ec.core.undo(ec);
+  REQUIRE(buffer == std::string(10000, 'a'));
+  ec.core.redo(ec);
+  REQUIRE(buffer.substr(4999, 4) == "abca");
+
+  // Deleted nodes are compacted once the history is over budget
+  std::vector<Node*> nodes;
+  std::vector<NodeID> ids;  // The deleted nodes are freed when compacted
+  for (int i = 0; i < 50; ++i) {
+    auto* node = ec.core.createAddNode(ec, "Text", {static_cast<float>(i) * 10, 5});
+    getText(node) = "Node" + std::to_string(i);
+    nodes.push_back(node);
+    ids.push_back(node->uID);
+  }
+  for (int i = 0; i < 49; ++i) {
+    ec.core.addConnection(new Connection(*nodes[i], nodes[i]->components[0], nodes[i]->components[0]->outputs[0],
+                                         *nodes[i + 1], nodes[i + 1]->components[0],
+                                         nodes[i + 1]->components[0]->inputs[0]));
+  }
+  const auto connectionCount = ec.core.connections.size();
+  for (int i = 0; i < 25; ++i) {
+    ec.core.selectedNodes.insert({nodes[i]->uID, nodes[i]});
+  }
+  ec.core.erase(ec);
+  auto* erased = static_cast<NodeDeleteAction*>(ec.core.actionQueue.back());
+  REQUIRE(ec.core.nodes.size() == 26);
+  const auto erasedBytes = erased->getMemory();
+
+  constexpr int moves = 3000;
+  for (int i = 0; i < moves; ++i) {
+    auto* move = new NodeMovedAction(1);
+    move->movedNodes.push_back({nodes[30]->uID, {-1, 0}});
+    nodes[30]->x += 1;
+    ec.core.addEditorAction(ec, move);
+  }
+  REQUIRE_FALSE(erased->isCompact());
+
+  ec.core.historyBudget = historyBytes(ec) - erasedBytes / 2;
+  const auto queueSize = ec.core.actionQueue.size();
+  auto* move = new NodeMovedAction(1);
+  move->movedNodes.push_back({nodes[30]->uID, {0, 0}});
+  ec.core.addEditorAction(ec, move);
+  REQUIRE(erased->isCompact());
+  REQUIRE(erased->getMemory() < erasedBytes / 4);
+  REQUIRE(ec.core.actionQueue.size() == queueSize + 1);  // Nothing was dropped
+  REQUIRE(historyBytes(ec) <= ec.core.historyBudget);
+
+  // Undo restores the nodes with their ids, state and connections
+  for (int i = 0; i <= moves; ++i) {
+    ec.core.undo(ec);
+  }
+  ec.core.undo(ec);
+  REQUIRE(ec.core.nodes.size() == 51);
+  REQUIRE(ec.core.connections.size() == connectionCount);
+  for (int i = 0; i < 25; ++i) {
+    auto* restored = ec.core.getNode(ids[i]);
+    REQUIRE(restored != nullptr);
+    REQUIRE(restored->x == static_cast<float>(i) * 10);
+    REQUIRE(getText(restored) == "Node" + std::to_string(i));
+  }
+  ec.core.redo(ec);
+  REQUIRE(ec.core.nodes.size() == 26);
+  REQUIRE(ec.core.connections.size() == 24);
+
+  // Without anything to compact the oldest actions are dropped
+  ec.core.historyBudget = 1;
+  ec.core.addEditorAction(ec, new NodeMovedAction(1));
+  REQUIRE(ec.core.actionQueue.size() == 2);
+  REQUIRE(ec.core.currentActionIndex == 1);
 }
\ No newline at end of file
@@ -0,0 +1,369 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch_amalgamated.hpp>
+
+#include "TestUtil.h"
+
+namespace {
+Connection* Connect(EditorContext& ec, Node& from, Node& to) {
+  auto* conn = new Connection(from, from.components[0], from.components[0]->outputs[0], to, to.components[0],
+                              to.components[0]->inputs[0]);
+  ec.core.addConnection(conn);
+  return conn;
+}
+int IndexOf(EditorContext& ec, const Node* n) {
+  const auto& order = ec.core.getUpdateOrder();
+  return static_cast<int>(std::ranges::find(order, n) - order.begin());
+}
+}  // namespace
+
+TEST_CASE("Test update order of unconnected nodes", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  for (int i = 0; i < 5; ++i) {
+    ec.core.createAddNode(ec, "Int", {0, 0});
+  }
+
+  // Same as the reverse draw order
+  const auto& order = ec.core.getUpdateOrder();
+  REQUIRE(order.size() == 5);
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(order[i] == ec.core.nodes[4 - i]);
+  }
+}
+
+TEST_CASE("Test update order follows connections", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  auto* a = ec.core.createAddNode(ec, "Int", {0, 0});
+  auto* b = ec.core.createAddNode(ec, "Int", {0, 0});
+  auto* c = ec.core.createAddNode(ec, "Int", {0, 0});
+
+  // c -> a -> b
+  Connect(ec, *c, *a);
+  auto* last = Connect(ec, *a, *b);
+  REQUIRE(IndexOf(ec, c) < IndexOf(ec, a));
+  REQUIRE(IndexOf(ec, a) < IndexOf(ec, b));
+
+  // Order is rebuilt after removal
+  ec.core.removeConnection(last);
+  delete last;
+  Connect(ec, *b, *c);
+  REQUIRE(IndexOf(ec, b) < IndexOf(ec, c));
+  REQUIRE(IndexOf(ec, c) < IndexOf(ec, a));
+
+  // Feedback loop still contains every node once
+  Connect(ec, *a, *b);
+  REQUIRE(ec.core.getUpdateOrder().size() == 3);
+}
+
+TEST_CASE("Test long chain settles in one tick", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  constexpr int chainSize = 2000;
+
+  // Created back to front - worst case for the old update order
+  std::vector<Node*> chain;
+  for (int i = 0; i < chainSize; ++i) {
+    chain.push_back(ec.core.createAddNode(ec, "Int", {0, 0}));
+  }
+  for (int i = chainSize - 1; i > 0; --i) {
+    Connect(ec, *chain[i], *chain[i - 1]);
+  }
+
+  const auto& order = ec.core.getUpdateOrder();
+  REQUIRE(order.size() == chainSize);
+  REQUIRE(order.front() == chain.back());
+  REQUIRE(order.back() == chain.front());
+
+  BENCHMARK("Build update order") {
+    ec.core.isOrderDirty = true;
+    return ec.core.getUpdateOrder().size();
+  };
+}
+
+TEST_CASE("Test dirty flags only propagate changes", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  auto* a = ec.core.createAddNode(ec, "Int", {0, 0});
+  auto* b = ec.core.createAddNode(ec, "Int", {0, 0});
+  auto* c = ec.core.createAddNode(ec, "Int", {0, 0});
+  Connect(ec, *a, *b);
+  Connect(ec, *b, *c);
+
+  // Same as the editor tick without the input handling
+  auto tick = [&ec] {
+    for (auto* n : ec.core.getUpdateOrder()) {
+      for (auto* comp : n->components) {
+        if (!comp->needsUpdate()) continue;
+        comp->clearDirty();
+        comp->update(ec, *n);
+      }
+    }
+  };
+
+  tick();
+  for (auto* n : {a, b, c}) {
+    REQUIRE_FALSE(n->components[0]->needsUpdate());
+  }
+
+  // Same value - nothing to do
+  a->components[0]->outputs[0].setData<FLOAT>(0.0);
+  REQUIRE_FALSE(b->components[0]->needsUpdate());
+
+  a->components[0]->outputs[0].setData<FLOAT>(5.0);
+  REQUIRE(b->components[0]->needsUpdate());
+  REQUIRE_FALSE(c->components[0]->needsUpdate());
+
+  // Whole chain settles within one tick
+  tick();
+  REQUIRE(c->components[0]->outputs[0].data.get<FLOAT>() == 5.0);
+  REQUIRE_FALSE(c->components[0]->needsUpdate());
+}
+
+TEST_CASE("Test fixed timestep accumulator", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  auto& core = ec.core;
+
+  // 10 kHz simulation with a 60 Hz display
+  core.tickRate = 10000.0F;
+  int ticks = 0;
+  for (int i = 0; i < 60; ++i) {
+    ticks += core.advanceTime(1.0F / 60.0F);
+  }
+  REQUIRE(ticks >= 9999);
+  REQUIRE(ticks <= 10000);
+
+  // Slower than the frame rate - most frames don't tick
+  core.tickRate = 10.0F;
+  core.tickAccumulator = 0.0F;
+  ticks = 0;
+  for (int i = 0; i < 60; ++i) {
+    ticks += core.advanceTime(1.0F / 60.0F);
+  }
+  REQUIRE(ticks >= 9);
+  REQUIRE(ticks <= 10);
+
+  // Stalls are capped
+  core.tickAccumulator = 0.0F;
+  REQUIRE(core.advanceTime(5.0F) == static_cast<int>(Core::MAX_FRAME_TIME * core.tickRate));
+}
+
+TEST_CASE("Test feedback loops only advance on ticks", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  auto& core = ec.core;
+  core.tickRate = 10.0F;
+
+  // Two cosines feeding each other change their output on every evaluation
+  auto* a = core.createAddNode(ec, "Int", {0, 0});
+  auto* b = core.createAddNode(ec, "Int", {0, 0});
+  for (auto* n : {a, b}) {
+    static_cast<MathC*>(n->components[0])->dropDown.selectedIndex = Cos;
+  }
+  Connect(ec, *a, *b);
+  Connect(ec, *b, *a);
+  auto output = [a] { return a->components[0]->outputs[0].data.get<FLOAT>(); };
+
+  REQUIRE(core.updateNodes(ec, 0.1F) == 1);
+  const auto tick = core.simulationTick;
+  const auto value = output();
+
+  // 60 Hz frames - only every sixth one has a due tick
+  for (int i = 0; i < 5; ++i) {
+    REQUIRE(core.updateNodes(ec, 1.0F / 60.0F) == 0);
+    REQUIRE(core.simulationTick == tick);
+    REQUIRE(output() == value);
+  }
+  REQUIRE(core.updateNodes(ec, 1.0F / 60.0F + 0.001F) == 1);
+  REQUIRE(core.simulationTick == tick + 1);
+  REQUIRE(output() != value);
+}
+
+TEST_CASE("Test grouped nodes advance once per tick", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  auto& core = ec.core;
+  core.tickRate = 10.0F;
+
+  // The same cosine feedback loop with a downstream node - once inside a collapsed group and once without
+  const auto makeLoop = [&ec, &core] {
+    auto* a = core.createAddNode(ec, "Int", {0, 0});
+    auto* b = core.createAddNode(ec, "Int", {0, 0});
+    auto* c = core.createAddNode(ec, "Int", {0, 0});
+    for (auto* n : {a, b, c}) {
+      static_cast<MathC*>(n->components[0])->dropDown.selectedIndex = Cos;
+    }
+    Connect(ec, *a, *b);
+    Connect(ec, *b, *a);
+    Connect(ec, *a, *c);
+    return std::tuple{a, b, c};
+  };
+  const auto [groupedA, groupedB, groupedC] = makeLoop();
+  const auto [freeA, freeB, freeC] = makeLoop();
+  auto& group = core.nodeGroups.emplace_back(0.0F, 0.0F, "Group", false);
+  group.addNode(ec, *groupedA);
+  group.addNode(ec, *groupedB);
+  auto output = [](const Node* n) { return n->components[0]->outputs[0].data.get<FLOAT>(); };
+
+  // Frames with and without catch-up ticks
+  for (const float frameTime : {0.1F, 0.25F, 1.0F / 60.0F, 0.3F}) {
+    core.updateNodes(ec, frameTime);
+    for (auto& g : core.nodeGroups) {
+      g.update(ec);
+    }
+    REQUIRE(output(groupedA) == output(freeA));
+    REQUIRE(output(groupedB) == output(freeB));
+    REQUIRE(output(groupedC) == output(freeC));  // Grouped nodes are evaluated in dependency order too
+  }
+}
+
+TEST_CASE("Test spatial grid queries", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  auto& grid = ec.core.grid;
+  std::vector<Node*> found;
+
+  // Spans multiple cells - still reported once
+  auto* big = ec.core.createAddNode(ec, "Int", {-100, -100});
+  big->width = SpatialGrid::CELL_SIZE * 3;
+  big->height = SpatialGrid::CELL_SIZE * 2;
+  grid.update(*big);
+  auto* far = ec.core.createAddNode(ec, "Int", {5000, 5000});
+
+  grid.query(Rectangle{-1000, -1000, 2000, 2000}, found);
+  REQUIRE(found.size() == 1);
+  REQUIRE(found[0] == big);
+
+  found.clear();
+  grid.query(Vector2{5010, 5010}, found);
+  REQUIRE(found.size() == 1);
+  REQUIRE(found[0] == far);
+
+  // Moved nodes are found at the new position
+  far->x = -50;
+  far->y = -50;
+  grid.update(*far);
+  found.clear();
+  grid.query(Vector2{0, 0}, found);
+  REQUIRE(found.size() == 2);
+  found.clear();
+  grid.query(Vector2{5010, 5010}, found);
+  REQUIRE(found.empty());
+
+  // Queries bigger than the occupied cells walk the cells instead
+  found.clear();
+  grid.query(Rectangle{-1e6F, -1e6F, 2e6F, 2e6F}, found);
+  REQUIRE(found.size() == 2);
+
+  ec.core.removeNode(ec, big->uID);
+  delete big;
+  found.clear();
+  grid.query(Vector2{0, 0}, found);
+  REQUIRE(found.size() == 1);
+  REQUIRE(found[0] == far);
+}
+
+TEST_CASE("Test deleting connected nodes", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  ec.core.loadCore(ec);  // Sets up the action queue
+  constexpr int chainSize = 5000;
+
+  std::vector<Node*> chain;
+  for (int i = 0; i < chainSize; ++i) {
+    chain.push_back(ec.core.createAddNode(ec, "Int", {0, 0}));
+  }
+  for (int i = 1; i < chainSize; ++i) {
+    Connect(ec, *chain[i - 1], *chain[i]);
+  }
+  REQUIRE(ec.core.getConnections(*chain[0]).size() == 1);
+  REQUIRE(ec.core.getConnections(*chain[1]).size() == 2);
+
+  // Keep the first node - its only connection is removed as well
+  for (int i = 1; i < chainSize; ++i) {
+    ec.core.selectedNodes.insert({chain[i]->uID, chain[i]});
+  }
+  ec.core.erase(ec);
+  REQUIRE(ec.core.nodes.size() == 1);
+  REQUIRE(ec.core.connections.empty());
+  REQUIRE(ec.core.getConnections(*chain[0]).empty());
+  REQUIRE_FALSE(chain[0]->components[0]->outputs[0].connections);
+
+  ec.core.undo(ec);
+  REQUIRE(ec.core.nodes.size() == chainSize);
+  REQUIRE(ec.core.connections.size() == chainSize - 1);
+  REQUIRE(ec.core.getConnections(*chain[1]).size() == 2);
+}
+
+TEST_CASE("Test connection handles", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  auto* a = ec.core.createAddNode(ec, "Int", {0, 0});
+  auto* b = ec.core.createAddNode(ec, "Int", {0, 0});
+  auto* c = ec.core.createAddNode(ec, "Int", {0, 0});
+
+  auto* first = Connect(ec, *a, *b);
+  auto* second = Connect(ec, *b, *c);
+  const auto handle = ec.core.getHandle(*first);
+  REQUIRE(ec.core.getConnection(handle) == first);
+
+  // Removal keeps the remaining connections reachable
+  ec.core.removeConnection(first);
+  REQUIRE(ec.core.connections.size() == 1);
+  REQUIRE(ec.core.getConnection(handle) == nullptr);
+  REQUIRE(ec.core.getConnection(ec.core.getHandle(*second)) == second);
+
+  // Reused slots don't resolve old handles
+  ec.core.addConnection(first);
+  REQUIRE(ec.core.connections.size() == 2);
+  REQUIRE(ec.core.getHandle(*first).slot == handle.slot);
+  REQUIRE(ec.core.getConnection(handle) == nullptr);
+  REQUIRE(ec.core.getConnection(ec.core.getHandle(*first)) == first);
+
+  BENCHMARK("Remove and add 10000 connections") {
+    std::vector<Connection*> removed;
+    for (int i = 0; i < 5000; ++i) {
+      removed.push_back(Connect(ec, *a, *c));
+      removed.push_back(Connect(ec, *c, *b));
+    }
+    for (const auto conn : removed) {
+      ec.core.removeConnection(conn);
+      delete conn;
+    }
+    return ec.core.connections.size();
+  };
+}
+
+TEST_CASE("Test object pool", "[Core]") {
+  auto ec = TestUtil::getBasicContext();
+  ec.core.loadCore(ec);
+  const auto liveBefore = ObjectPool::GetLiveCount();
+
+  auto* first = ec.core.createAddNode(ec, "Int", {0, 0});
+  Connect(ec, *first, *ec.core.createAddNode(ec, "Int", {0, 0}));
+  REQUIRE(ObjectPool::GetLiveCount() > liveBefore);
+
+  ec.core.selectedNodes.insert({first->uID, first});
+  ec.core.erase(ec);
+  ec.core.resetEditor(ec);
+  REQUIRE(ObjectPool::GetLiveCount() == liveBefore);
+
+  BENCHMARK("Create and reset 10000 nodes") {
+    for (int i = 0; i < 10000; ++i) {
+      ec.core.createAddNode(ec, "Int", {0, 0});
+    }
+    ec.core.resetEditor(ec);
+    return ec.core.nodes.size();
+  };
+}
@@ -19,9 +19,12 @@
 // SOFTWARE.
 
 #include <catch_amalgamated.hpp>
+#include <filesystem>
 
 #include "RnImport.h"
+#include "RnCodegen.h"
 #include "TestUtil.h"
+#include "Test1Nodes.h"  // Generated from res/Test1.rn by rn_codegen
 
 TEST_CASE("Test getComponentData", "[Import]") {
   TestUtil::SetupCWD();
@@ -197,6 +200,78 @@ TEST_CASE("Test getConnectionIn", "[Import]") {
   REQUIRE(rn.getConnectionsIn(2, -1).empty());
   REQUIRE(rn.getConnectionsIn<1>(2, -1)[0].isValid() == false);
 }
+TEST_CASE("Test connection views", "[Import]") {
+  TestUtil::SetupCWD();
+  auto rn = raynodes::importRN("res/Test1.rn");
+
+  // Same connections and order as the filtering overloads
+  const auto in = rn.getConnectionsInView(5);
+  const auto inVec = rn.getConnectionsIn(5);
+  REQUIRE(in.size() == 2);
+  REQUIRE(in.size() == inVec.size());
+  for (size_t i = 0; i < in.size(); ++i) {
+    REQUIRE(in[i].fromNode == inVec[i].fromNode);
+    REQUIRE(in[i].toNode == 5);
+  }
+
+  const auto out = rn.getConnectionsOutView(2);
+  REQUIRE(out.size() == 2);
+  REQUIRE(out[0].toPin == 0);
+  REQUIRE(out[1].toPin == 1);
+
+  size_t total = 0;
+  for (int i = 0; i < rn.nodeCnt; ++i) {
+    total += rn.getConnectionsOutView(static_cast<raynodes::NodeID>(i)).size();
+  }
+  REQUIRE(total == rn.connCnt);
+
+  // No connections or unknown node
+  REQUIRE(rn.getConnectionsInView(2).empty());
+  REQUIRE(rn.getConnectionsOutView(100).empty());
+}
+TEST_CASE("Test full index", "[Import]") {
+  TestUtil::SetupCWD();
+  auto rn = raynodes::importRN("res/Test1.rn");
+  auto full = raynodes::importRN("res/Test1.rn", true);
+  REQUIRE(rn.fieldOffsets == nullptr);
+  REQUIRE(full.fieldCnt > 0);
+
+  // Same results in both modes - also for accesses outside the recorded fields
+  for (int n = 0; n < rn.nodeCnt; ++n) {
+    const auto id = static_cast<raynodes::NodeID>(n);
+    for (int c = 0; c < COMPS_PER_NODE; ++c) {
+      for (int i = 0; i < 3; ++i) {
+        REQUIRE(rn.getComponentData<raynodes::STRING>(id, c, i) == full.getComponentData<raynodes::STRING>(id, c, i));
+      }
+    }
+  }
+  REQUIRE(full.getComponentData<raynodes::STRING>(5, "Choice4") == "C4");
+  REQUIRE(full.getComponentData<raynodes::FLOAT>(2, "Number") == 2.33);
+  REQUIRE(full.getComponentData<raynodes::VECTOR_3>(3, 0).z == 1.3333F);
+}
+TEST_CASE("Test mapped import", "[Import]") {
+  TestUtil::SetupCWD();
+  auto rn = raynodes::importRN("res/Test1.rn");
+  auto mapped = raynodes::importRNMapped("res/Test1.rn");
+#ifndef _WIN32
+  REQUIRE(mapped.isMapped == true);
+#endif
+  REQUIRE(mapped.nodeCnt == rn.nodeCnt);
+  REQUIRE(mapped.connCnt == rn.connCnt);
+  REQUIRE(mapped.getComponentData<raynodes::STRING>(5, "Choice4") == "C4");
+  REQUIRE(mapped.getComponentData<raynodes::FLOAT>(2, "Number") == 2.33);
+
+  // Views point into the mapping
+  const auto view = mapped.getNodeName(0);
+  REQUIRE(view.start >= mapped.fileData);
+  REQUIRE(view.start < mapped.fileData + mapped.size);
+  REQUIRE(view.getString() == "TextField");
+
+  // Missing file
+  auto missing = raynodes::importRNMapped("res/__MISSING__.rn");
+  REQUIRE(missing.fileData == nullptr);
+  REQUIRE(missing.nodeCnt == 0);
+}
 TEST_CASE("Test getNodes", "[Import]") {
   TestUtil::SetupCWD();
   auto rn = raynodes::importRN("res/Test1.rn");
@@ -215,11 +290,102 @@ TEST_CASE("Test getNodes", "[Import]") {
     REQUIRE(nodes[0] == 0);
     REQUIRE(nodes[1] == 1);
   }
+  // Precomputed view
+  {
+    const auto view = rn.getNodesView("TextField");
+    REQUIRE(view.size() == 2);
+    REQUIRE(view[0] == 0);
+    REQUIRE(view[1] == 1);
+    REQUIRE(rn.getNodesView("Dialog Choice").size() == 1);
+    REQUIRE(rn.getNodesView("Dialog Choice")[0] == 5);
+    REQUIRE(rn.getNodesView("Vector3")[0] == 3);
+    REQUIRE(rn.getNodesView("Dialog").empty());      // Template without nodes
+    REQUIRE(rn.getNodesView("TextFieldd").empty());  // Only exact names
+  }
   // Empty
   REQUIRE(rn.getNodes("aöalsföd").empty() == true);
   // Empty
   REQUIRE(rn.getNodes(nullptr).empty() == true);
 }
+TEST_CASE("Test header generation", "[Import]") {
+  TestUtil::SetupCWD();
+  const auto rn = raynodes::importRN("res/Test1.rn");
+  const auto header = raynodes::GenerateHeader(rn, "quest");
+
+  REQUIRE(header.find("namespace quest {") != std::string::npos);
+  REQUIRE(header.find("struct DialogChoice {") != std::string::npos);
+  REQUIRE(header.find("NAME = \"Dialog Choice\";") != std::string::npos);
+  REQUIRE(header.find("static constexpr raynodes::ComponentIndex NPCType = 0;") != std::string::npos);
+  REQUIRE(header.find("static constexpr raynodes::ComponentIndex Choice4 = 5;") != std::string::npos);
+  REQUIRE(header.find("std::string npcType{};") != std::string::npos);
+  REQUIRE(header.find("std::string choices[4]{};") != std::string::npos);
+  REQUIRE(header.find("n.choices[3] = rn.getComponentData<raynodes::STRING>(node, 5);") != std::string::npos);
+
+  // Types are inferred from the saved data
+  REQUIRE(header.find("double number{};") != std::string::npos);
+  REQUIRE(header.find("raynodes::Vec3 vec3{};") != std::string::npos);
+  REQUIRE(header.find("raynodes::Vec2 vec2{};") != std::string::npos);
+  REQUIRE(header.find("int64_t operation{};") != std::string::npos);
+  REQUIRE(header.find("std::string text{};") != std::string::npos);
+}
+TEST_CASE("Test generated header", "[Import]") {
+  TestUtil::SetupCWD();
+  const auto rn = raynodes::importRN("res/Test1.rn");
+  static_assert(quest::DialogChoice::Comp::Choice4 == 5);
+
+  const auto choices = quest::DialogChoice::DecodeAll(rn);
+  REQUIRE(choices.size() == rn.getNodesView("Dialog Choice").size());
+  REQUIRE_FALSE(choices.empty());
+  for (const auto& choice : choices) {
+    REQUIRE(choice.npcType == rn.getComponentData<raynodes::STRING>(choice.id, "NPCType"));
+    REQUIRE(choice.choices[3] == rn.getComponentData<raynodes::STRING>(choice.id, "Choice4"));
+  }
+}
+TEST_CASE("Test header generation avoids duplicate names", "[Import]") {
+  // Labels and names that only differ in stripped characters or hit the fixed declarations
+  std::string file = "--EditorData--\n1\0370\0370\0370\0371\037\n--Templates--\n4\037\n";
+  file += "0\037my Node\037ID\037Value\037Val-ue\037Comp\037MyNode\037\037255\037\n";
+  file += "1\037my-Node\037Text\037\037\037\037\037\037255\037\n";
+  file += "2\037int\037class\037std\037\037\037\037\037255\037\n";
+  file += "3\037Say \"Hi\" \\\037Text\037\037\037\037\037\037255\037\n--Nodes--\n";
+  file += "0\0370\0370\037\0351\037\0352\037\0353\037\0354\037\035\0370\0370\037\n--Connections--\n";
+  const auto rn = TestUtil::ImportFromString(file);
+  REQUIRE(rn.fileData != nullptr);
+  const auto header = raynodes::GenerateHeader(rn);
+
+  REQUIRE(header.find("struct myNode {") != std::string::npos);
+  REQUIRE(header.find("struct myNode_2 {") != std::string::npos);
+  REQUIRE(header.find("int64_t id_2{};") != std::string::npos);
+  REQUIRE(header.find("int64_t value{};") != std::string::npos);
+  REQUIRE(header.find("int64_t value_2{};") != std::string::npos);
+  REQUIRE(header.find("n.value_2 = rn.getComponentData<raynodes::INTEGER>(node, 2);") != std::string::npos);
+  REQUIRE(header.find("ComponentIndex Value_2 = 2;") != std::string::npos);
+  REQUIRE(header.find("ComponentIndex Comp_2 = 3;") != std::string::npos);
+  REQUIRE(header.find("int64_t myNode_2{};") != std::string::npos);  // Member named like its struct
+
+  // Keywords and names the header uses get a suffix - the name is escaped in the literal
+  REQUIRE(header.find("struct int_2 {") != std::string::npos);
+  REQUIRE(header.find("std::string class_2{};") != std::string::npos);
+  REQUIRE(header.find("std::string std_2{};") != std::string::npos);
+  REQUIRE(header.find("ComponentIndex class_2 = 0;") != std::string::npos);
+  REQUIRE(header.find("NAME = \"Say \\\"Hi\\\" \\\\\";") != std::string::npos);
+
+  // Every declaration in a struct is unique
+  std::vector<std::string> names;
+  size_t pos = 0;
+  while ((pos = header.find('\n', pos)) != std::string::npos) {
+    const auto line = header.substr(pos + 1, header.find('\n', pos + 1) - pos - 1);
+    pos++;
+    if (line.starts_with("struct ")) names.clear();
+    const auto end = line.find_first_of("{[=(");
+    if (!line.starts_with("  ") || line.starts_with("    ") || end == std::string::npos) continue;
+    const auto declaration = line.substr(0, line.find_last_not_of(' ', end - 1) + 1);
+    const auto name = declaration.substr(declaration.find_last_of(' ') + 1);
+    REQUIRE(std::ranges::find(names, name) == names.end());
+    names.push_back(name);
+  }
+}
+
 TEST_CASE("Test getNodeName", "[Import]") {
   TestUtil::SetupCWD();
   auto rn = raynodes::importRN("res/Test1.rn");
@@ -267,10 +433,228 @@ TEST_CASE("Test completeness - static tests", "[Import]") {
   REQUIRE(rn.connections[1].toComponent == -1);
   REQUIRE(rn.connections[1].toPin == 0);
 }
+TEST_CASE("Test node lookup with id gaps", "[Import]") {
+  // Deleting nodes leaves gaps - ids can be bigger than the node count
+  const auto makeImport = [](const char* nodes) {
+    std::string file = "--EditorData--\n3\0370\0370\0370\0371\037\n--Templates--\n1\037\n";
+    file += "0\037TextField\037Text\037\037\037\037\037\037255\037\n--Nodes--\n";
+    file += nodes;
+    file += "--Connections--\n";
+    return TestUtil::ImportFromString(file);
+  };
+
+  // Dense
+  {
+    auto rn = makeImport("0\0379\037Nine\037\035\0370\0370\037\n0\0370\037Zero\037\035\0370\0370\037\n"
+                         "0\0373\037Three\037\035\0370\0370\037\n");
+    REQUIRE(rn.isDenseIndex == true);
+    REQUIRE(rn.getComponentData<raynodes::STRING>(9, 0) == "Nine");
+    REQUIRE(rn.getComponentData<raynodes::STRING>(3, "Text") == "Three");
+    REQUIRE(rn.getComponentData<raynodes::STRING>(0, 0) == "Zero");
+    REQUIRE(rn.getNodeName(9).getString() == "TextField");
+    REQUIRE(rn.getNodeName(4).start == nullptr);
+    REQUIRE(rn.getNodeName(10).start == nullptr);
+  }
+
+  // Sparse
+  {
+    auto rn = makeImport("0\03740000\037Far\037\035\0370\0370\037\n0\0370\037Zero\037\035\0370\0370\037\n"
+                         "0\037500\037Mid\037\035\0370\0370\037\n");
+    REQUIRE(rn.isDenseIndex == false);
+    REQUIRE(rn.getComponentData<raynodes::STRING>(40000, 0) == "Far");
+    REQUIRE(rn.getComponentData<raynodes::STRING>(500, "Text") == "Mid");
+    REQUIRE(rn.getComponentData<raynodes::STRING>(0, 0) == "Zero");
+    REQUIRE(rn.getNodeName(501).start == nullptr);
+    REQUIRE(rn.getNodeName(UINT16_MAX).start == nullptr);
+  }
+}
+TEST_CASE("Test component columns", "[Import]") {
+  // Every third node is a Vector2 - the rest NumberFields
+  constexpr int NODES = 3000;
+  std::string file = "--EditorData--\n" + std::to_string(NODES) + "\0370\0370\0370\0371\037\n--Templates--\n2\037\n";
+  file += "0\037NumberField\037Number\037\037\037\037\037\037255\037\n";
+  file += "1\037Vector2\037Vec2\037\037\037\037\037\037255\037\n--Nodes--\n";
+  for (int i = 0; i < NODES; ++i) {
+    if (i % 3 == 0) file += "1\037" + std::to_string(i) + "\037" + std::to_string(i) + ";0.5\037\035\0370\0370\037\n";
+    else file += "0\037" + std::to_string(i) + "\037" + std::to_string(i) + ".25\037\035\0370\0370\037\n";
+  }
+  file += "--Connections--\n";
+
+  for (const bool fullIndex : {false, true}) {
+    auto rn = TestUtil::ImportFromString(file, fullIndex);
+
+    const int count = rn.getComponentColumn<raynodes::FLOAT, double>("NumberField", 0, nullptr, 0);
+    REQUIRE(count == NODES - NODES / 3);
+    std::vector<double> numbers(count);
+    REQUIRE(rn.getComponentColumn<raynodes::FLOAT>("NumberField", "Number", numbers.data(), count) == count);
+    const auto ids = rn.getNodesView("NumberField");
+    for (int i = 0; i < count; ++i) {
+      REQUIRE(numbers[i] == rn.getComponentData<raynodes::FLOAT>(ids[i], 0));
+    }
+    REQUIRE(numbers[0] == 1.25);
+    REQUIRE(numbers[1] == 2.25);
+
+    // Capacity limits the written values but not the returned count
+    std::array<raynodes::Vec2, 4> vectors{};
+    REQUIRE(rn.getComponentColumn<raynodes::VECTOR_2>("Vector2", 0, vectors.data(), 3) == NODES / 3);
+    REQUIRE(vectors[2].x == 6.0F);
+    REQUIRE(vectors[2].y == 0.5F);
+    REQUIRE(vectors[3].x == 0.0F);
+
+    REQUIRE(rn.getComponentColumn<raynodes::FLOAT>("Vector3", 0, numbers.data(), count) == 0);
+    REQUIRE(rn.getComponentColumn<raynodes::FLOAT>("NumberField", "Vec2", numbers.data(), count) == 0);
+    REQUIRE(rn.getComponentColumn<raynodes::FLOAT>("NumberField", -1, numbers.data(), count) == 0);
+
+    if (fullIndex) continue;
+    BENCHMARK("Column") {
+      return rn.getComponentColumn<raynodes::FLOAT>("NumberField", 0, numbers.data(), count);
+    };
+    BENCHMARK("Per node") {
+      for (int i = 0; i < count; ++i) {
+        numbers[i] = rn.getComponentData<raynodes::FLOAT>(ids[i], "Number");
+      }
+      return numbers[0];
+    };
+  }
+}
+TEST_CASE("Test parallel import", "[Import]") {
+  // About 12 MB - enough for every thread to get its own chunk
+  constexpr int NODES = 30000;
+  constexpr int CONNECTIONS = 20000;
+  std::string file = "--EditorData--\n" + std::to_string(NODES) + "\037" + std::to_string(CONNECTIONS);
+  file += "\0370\0370\0371\037\n--Templates--\n2\037\n";
+  file += "0\037TextField\037Text\037\037\037\037\037\037255\037\n";
+  file += "1\037Vector2\037Vec2\037\037\037\037\037\037255\037\n--Nodes--\n";
+  const std::string text(400, 'x');
+  for (int i = 0; i < NODES; ++i) {
+    if (i % 5 == 0) file += "1\037" + std::to_string(i) + "\037" + std::to_string(i) + ";1\037\035\0370\0370\037\n";
+    else file += "0\037" + std::to_string(i) + "\037" + text + std::to_string(i) + "\037\035\0370\0370\037\n";
+  }
+  file += "--Connections--\n";
+  for (int i = 0; i < CONNECTIONS; ++i) {
+    file += std::to_string(i) + "\037-1\0370\037" + std::to_string((i * 7) % NODES) + "\037-1\0370\037\n";
+  }
+  const auto import = [&file](const int threads) { return TestUtil::ImportFromString(file, true, threads); };
+
+  const auto sequential = import(1);
+  for (const int threads : {3, 8, 0}) {
+    const auto parallel = import(threads);
+    REQUIRE(parallel.nodeCnt == NODES);
+    REQUIRE(parallel.connCnt == CONNECTIONS);
+    for (int i = 0; i < NODES; ++i) {
+      REQUIRE(parallel.nodes[i].startByte == sequential.nodes[i].startByte);
+      REQUIRE(parallel.nodes[i].id == sequential.nodes[i].id);
+      REQUIRE(parallel.nodes[i].tID == sequential.nodes[i].tID);
+    }
+    for (int i = 0; i < CONNECTIONS; ++i) {
+      const auto& [fromNode, fromComponent, fromPin, toNode, toComponent, toPin] = parallel.connections[i];
+      const auto& other = sequential.connections[i];
+      REQUIRE(fromNode == other.fromNode);
+      REQUIRE(fromComponent == other.fromComponent);
+      REQUIRE(fromPin == other.fromPin);
+      REQUIRE(toNode == other.toNode);
+      REQUIRE(toComponent == other.toComponent);
+      REQUIRE(toPin == other.toPin);
+    }
+    REQUIRE(parallel.fieldCnt == sequential.fieldCnt);
+    REQUIRE(std::memcmp(parallel.componentFields, sequential.componentFields,
+                        NODES * (COMPS_PER_NODE + 1) * sizeof(uint32_t)) == 0);
+    REQUIRE(std::memcmp(parallel.fieldOffsets, sequential.fieldOffsets, sequential.fieldCnt * sizeof(uint32_t)) == 0);
+    REQUIRE(parallel.getComponentData<raynodes::STRING>(NODES - 1, 0) == text + std::to_string(NODES - 1));
+    REQUIRE(parallel.getComponentData<raynodes::VECTOR_2>(NODES - 5, "Vec2").x == NODES - 5);
+    REQUIRE(parallel.getConnectionsIn(7).size() == 1);
+  }
+
+  BENCHMARK("Index sequential") {
+    return import(1).nodeCnt;
+  };
+  BENCHMARK("Index parallel") {
+    return import(0).nodeCnt;
+  };
+}
+TEST_CASE("Test wide files need RN_WIDE_IDS", "[Import]") {
+  const auto import = [](const std::string& editorData) {
+    std::string file = "--EditorData--\n" + editorData + "\n--Templates--\n1\037\n";
+    file += "0\037TextField\037Text\037\037\037\037\037\037255\037\n--Nodes--\n";
+    file += "0\0370\037Zero\037\035\0370\0370\037\n--Connections--\n";
+    return TestUtil::ImportFromString(file);
+  };
+  REQUIRE(import("1\0370\0370\0370\0371\037").fileData != nullptr);
+  REQUIRE(import("1\0370\0370\0370\0371\0372\037").fileData == nullptr);  // Format flag
+  REQUIRE(import("70000\0370\0370\0370\0371\037").fileData == nullptr);   // Too many nodes
+  REQUIRE(import("1\03770000\0370\0370\0371\037").fileData == nullptr);   // Too many connections
+  REQUIRE(import("1\0370\0370\0370\0371\037").getComponentData<raynodes::STRING>(0, 0) == "Zero");
+}
+TEST_CASE("Test vectorized separator skipping", "[Import]") {
+  // Every start offset, count and terminator position against the scalar version
+  std::string data;
+  for (int i = 0; i < 200; ++i) {
+    data += i % 7 == 0 ? SEPARATOR : i % 11 == 0 ? '\n' : static_cast<char>('a' + i % 26);
+  }
+  for (size_t start = 0; start < 80; ++start) {
+    for (int count = 0; count < 40; ++count) {
+      char* simd = data.data() + start;
+      char* scalar = data.data() + start;
+      _str_skip_char(simd, SEPARATOR, count);
+      _str_skip_char_scalar(scalar, SEPARATOR, count);
+      REQUIRE(simd == scalar);
+    }
+  }
+  char* end = data.data() + 150;
+  _str_skip_char(end, '\n', 1000);
+  REQUIRE(end == data.data() + data.size());
+}
 TEST_CASE("Benchmark the import", "[Import]") {
   TestUtil::SetupCWD();
   auto* path = "./res/__GEN2__.rn";
   BENCHMARK("Import") {
     auto rn = raynodes::importRN(path);
   };
-}
\ No newline at end of file
+  BENCHMARK("Import mapped") {
+    auto rn = raynodes::importRNMapped(path);
+  };
+}
+// Hidden - writes a large file to the temp directory. Run with: raynodes_test [Benchmark]
+TEST_CASE("Benchmark separator scanning", "[.][Benchmark]") {
+  // Generated project of about 100 MB - long text fields make up most of it
+  constexpr int nodeCount = 60000;
+  constexpr int textLength = 1700;
+  const auto path = std::filesystem::temp_directory_path() / "__GEN_LARGE__.rn";
+  {
+    std::string text(textLength, 'x');
+    for (int i = 0; i < textLength; i += 13) {
+      text[i] = static_cast<char>('a' + i % 26);
+    }
+    FILE* file = fopen(path.string().c_str(), "wb");
+    REQUIRE(file != nullptr);
+    fprintf(file, "--EditorData--\n%d\0370\0370\0370\0371\037\n--Templates--\n1\037\n", nodeCount);
+    fprintf(file, "0\037TextField\037Text\037\037\037\037\037\037255\037\n--Nodes--\n");
+    for (int i = 0; i < nodeCount; ++i) {
+      fprintf(file, "0\037%d\037%s\037\035%d\037%d\037\n", i, text.c_str(), i, -i);
+    }
+    fprintf(file, "--Connections--\n");
+    fclose(file);
+  }
+
+  auto rn = raynodes::importRNMapped(path.string().c_str());
+  REQUIRE(rn.nodeCnt == nodeCount);
+  REQUIRE(rn.getComponentData<raynodes::STRING>(nodeCount - 1, 0).size() == textLength);
+
+  BENCHMARK("Skip lines scalar") {
+    char* ptr = rn.fileData;
+    _str_skip_char_scalar(ptr, '\n', INT32_MAX);
+    return ptr;
+  };
+
+  BENCHMARK("Skip lines vectorized") {
+    char* ptr = rn.fileData;
+    _str_skip_char(ptr, '\n', INT32_MAX);
+    return ptr;
+  };
+
+  BENCHMARK("Import 100MB") {
+    return raynodes::importRNMapped(path.string().c_str()).nodeCnt;
+  };
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Same header compiled with the wide types - lives in its own inline namespace
+#define RN_WIDE_IDS
+#include <catch_amalgamated.hpp>
+
+#include "RnImport.h"
+#include "TestUtil.h"
+
+TEST_CASE("Test wide import", "[Import]") {
+  // More nodes, connections, ids and node types than the narrow import supports
+  // The templates section alone is bigger than 64 KB
+  constexpr int TEMPLATES = 700;
+  constexpr int NODES = 70000;
+  constexpr int FIRST_ID = 100000;
+  std::string file = "--EditorData--\n" + std::to_string(NODES) + "\037" + std::to_string(NODES - 1);
+  file += "\0370\0370\0371\037" + std::to_string(RN_FORMAT_WIDE) + "\037\n--Templates--\n";
+  file += std::to_string(TEMPLATES) + "\037\n";
+  for (int i = 0; i < TEMPLATES; ++i) {
+    file += std::to_string(i) + "\037Node" + std::to_string(i);
+    for (int c = 0; c < COMPS_PER_NODE; ++c) {
+      file += "\037LongLabelNumber" + std::to_string(c);
+    }
+    file += "\037255\037\n";
+  }
+  file += "--Nodes--\n";
+  for (int i = 0; i < NODES; ++i) {
+    file += std::to_string(i % TEMPLATES) + "\037" + std::to_string(FIRST_ID + i * 3) + "\037Text" + std::to_string(i);
+    file += "\037\035\0370\0370\037\n";
+  }
+  file += "--Connections--\n";
+  for (int i = 0; i + 1 < NODES; ++i) {
+    file += std::to_string(FIRST_ID + i * 3) + "\037-1\0370\037" + std::to_string(FIRST_ID + i * 3 + 3) + "\037-1\0370\037\n";
+  }
+  const auto rn = TestUtil::ImportFromString(file);
+
+  REQUIRE(sizeof(raynodes::NodeID) == 4);
+  REQUIRE(rn.fileData != nullptr);
+  REQUIRE(rn.nodeCnt == NODES);
+  REQUIRE(rn.connCnt == NODES - 1);
+  REQUIRE(rn.templateCnt == TEMPLATES);
+  REQUIRE(rn.templates[TEMPLATES - 1].startByte > UINT16_MAX);
+
+  constexpr raynodes::NodeID last = FIRST_ID + (NODES - 1) * 3;
+  REQUIRE(rn.getNodeName(last).getString() == "Node" + std::to_string((NODES - 1) % TEMPLATES));
+  REQUIRE(rn.getComponentData<raynodes::STRING>(last, "LongLabelNumber0") == "Text" + std::to_string(NODES - 1));
+  REQUIRE(rn.getComponentData<raynodes::STRING>(last - 1, 0).empty());
+  REQUIRE(rn.getNodesView("Node699").size() == NODES / TEMPLATES);
+  REQUIRE(rn.getNodesView("Node699")[0] == FIRST_ID + 699 * 3);
+
+  const auto out = rn.getConnectionsOut(last - 3);
+  REQUIRE(out.size() == 1);
+  REQUIRE(out[0].toNode == last);
+  REQUIRE(rn.getConnectionsIn(FIRST_ID).empty());
+  REQUIRE(rn.getConnectionsOut<2>(last)[0].isValid() == false);
+
+  // Narrow files can be read as well
+  TestUtil::SetupCWD();
+  const auto narrow = raynodes::importRN("res/Test1.rn");
+  REQUIRE(narrow.getComponentData<raynodes::STRING>(5, "Choice4") == "C4");
+  REQUIRE(narrow.getConnectionsOut(0).size() == 2);
+}
@@ -22,6 +22,7 @@
 #include <filesystem>
 
 #include "TestUtil.h"
+#include "application/elements/Action.h"
 
 TEST_CASE("Test correct file creation and count", "[Persist]") {
   TestUtil::SetupCWD();
@@ -37,6 +38,7 @@ TEST_CASE("Test correct file creation and count", "[Persist]") {
   ec.persist.openedFilePath = testPath;
   ec.core.hasUnsavedChanges = true;
   ec.persist.saveProject(ec);
+  REQUIRE(ec.persist.waitForSave(ec));
 
   // Reset state
   ec.core.resetEditor(ec);
@@ -91,6 +93,386 @@ TEST_CASE("Teset correct data persistence", "[Persist]") {
   }
 }
 
+TEST_CASE("Test buffered loading of positions and connections", "[Persist]") {
+  TestUtil::SetupCWD();
+  auto* testPath = "./res/__GEN1__.rn";
+  auto ec = TestUtil::getBasicContext();
+  ec.persist.openedFilePath = testPath;
+
+  auto* text = ec.core.createAddNode(ec, "Text", {150, -250});
+  text->getComponent<TextFieldC<>>("Text")->textField.buffer = "Line1\nLine2";
+  auto* display = ec.core.createAddNode(ec, "Text", {400, 35});
+  ec.core.addConnection(new Connection(*text, text->components[0], text->components[0]->outputs[0], *display,
+                                       display->components[0], display->components[0]->inputs[0]));
+
+  ec.core.hasUnsavedChanges = true;
+  ec.persist.saveProject(ec);
+  ec.core.resetEditor(ec);
+  ec.persist.importProject(ec);
+
+  REQUIRE(ec.core.nodes.size() == 2);
+  REQUIRE(ec.core.connections.size() == 1);
+  const auto* loaded = ec.core.getNode(NodeID(0));
+  REQUIRE(loaded->x == 150);
+  REQUIRE(loaded->y == -250);
+  REQUIRE(ec.core.getNode(NodeID(1))->x == 400);
+  REQUIRE(ec.core.getNode(NodeID(0))->getComponent<TextFieldC<>>("Text")->textField.buffer == "Line1\nLine2");
+  REQUIRE(&ec.core.connections[0]->toNode == ec.core.getNode(NodeID(1)));
+
+  // FILE* based loaders continue where the cursor is
+  ByteReader reader;
+  REQUIRE(reader.open(testPath));
+  cxstructs::io_load_newline(reader, true);
+  int nodeCount = 0;
+  cxstructs::io_load(reader.getFile(), nodeCount);
+  reader.syncFromFile();
+  int connectionCount = 0;
+  cxstructs::io_load(reader, connectionCount);
+  REQUIRE(nodeCount == 2);
+  REQUIRE(connectionCount == 1);
+}
+
+TEST_CASE("Test wide node ids", "[Persist]") {
+  TestUtil::SetupCWD();
+  auto* testPath = "./res/__GEN1__.rn";
+  auto ec = TestUtil::getBasicContext();
+  ec.persist.openedFilePath = testPath;
+
+  // Ids past the 16 bit range switch the file to the wide format
+  ec.core.UID = NodeID(70000);
+  auto* text = ec.core.createAddNode(ec, "Text", {10, 20});
+  auto* display = ec.core.createAddNode(ec, "Text", {30, 40});
+  ec.core.addConnection(new Connection(*text, text->components[0], text->components[0]->outputs[0], *display,
+                                       display->components[0], display->components[0]->inputs[0]));
+  REQUIRE(text->uID == 70000);
+
+  ec.core.hasUnsavedChanges = true;
+  ec.persist.saveProject(ec);
+  REQUIRE(ec.persist.waitForSave(ec));
+  ec.core.resetEditor(ec);
+
+  ByteReader reader;
+  REQUIRE(reader.open(testPath));
+  const std::string data(reader.cursor, reader.end);
+  const auto editorData = data.substr(data.find('\n') + 1);
+  REQUIRE(editorData.substr(0, editorData.find('\n')).ends_with("\0372\037"));
+
+  ec.persist.importProject(ec);
+  REQUIRE(ec.core.nodes.size() == 2);
+  REQUIRE(ec.core.getNode(NodeID(70001))->x == 30);
+  REQUIRE(&ec.core.connections[0]->toNode == ec.core.getNode(NodeID(70001)));
+  REQUIRE(ec.core.UID == 70002);
+
+  // Narrow projects dont have the flag - same files as before
+  ec.core.resetEditor(ec);
+  ec.core.createAddNode(ec, "Text", {});
+  ec.core.hasUnsavedChanges = true;
+  ec.persist.saveProject(ec);
+  REQUIRE(ec.persist.waitForSave(ec));
+  REQUIRE(reader.open(testPath));
+  const std::string narrow(reader.cursor, reader.end);
+  const auto narrowData = narrow.substr(narrow.find('\n') + 1);
+  REQUIRE(std::ranges::count(narrowData.substr(0, narrowData.find('\n')), '\037') == 5);
+
+  // The narrow import reserves the highest 16 bit id as INVALID_NODE
+  const auto fieldsAtID = [&](const uint32_t id) {
+    ec.core.resetEditor(ec);
+    ec.core.UID = NodeID(id);
+    ec.core.createAddNode(ec, "Text", {});
+    ec.core.hasUnsavedChanges = true;
+    ec.persist.saveProject(ec);
+    REQUIRE(ec.persist.waitForSave(ec));
+    REQUIRE(reader.open(testPath));
+    const std::string file(reader.cursor, reader.end);
+    const auto line = file.substr(file.find('\n') + 1);
+    return std::ranges::count(line.substr(0, line.find('\n')), '\037');
+  };
+  REQUIRE(fieldsAtID(UINT16_MAX - 1) == 5);
+  REQUIRE(fieldsAtID(UINT16_MAX) == 6);
+}
+
+TEST_CASE("Test background save writes the snapshot", "[Persist]") {
+  TestUtil::SetupCWD();
+  auto* testPath = "./res/__GEN1__.rn";
+  auto ec = TestUtil::getBasicContext();
+  ec.persist.openedFilePath = testPath;
+
+  auto* text = ec.core.createAddNode(ec, "Text", {150, -250});
+  text->getComponent<TextFieldC<>>("Text")->textField.buffer = "Saved";
+  auto* display = ec.core.createAddNode(ec, "Text", {400, 35});
+  ec.core.addConnection(new Connection(*text, text->components[0], text->components[0]->outputs[0], *display,
+                                       display->components[0], display->components[0]->inputs[0]));
+  ec.core.nodeGroups.emplace_back(10.0F, 20.0F, "Group", true).nodes.push_back(display);
+
+  ec.core.hasUnsavedChanges = true;
+  REQUIRE(ec.persist.saveProject(ec));
+
+  // Changes while the file is written dont end up in it
+  text->x = 1000;
+  text->getComponent<TextFieldC<>>("Text")->textField.buffer = "Changed";
+  ec.core.createAddNode(ec, "Text", {});
+  REQUIRE(ec.persist.waitForSave(ec));
+  REQUIRE(ec.core.hasUnsavedChanges == false);
+
+  ec.core.resetEditor(ec);
+  ec.persist.importProject(ec);
+  REQUIRE(ec.core.nodes.size() == 2);
+  REQUIRE(ec.core.connections.size() == 1);
+  REQUIRE(ec.core.nodeGroups.size() == 1);
+  REQUIRE(ec.core.nodeGroups[0].nodes.size() == 1);
+  REQUIRE(ec.core.getNode(NodeID(0))->x == 150);
+  REQUIRE(ec.core.getNode(NodeID(0))->getComponent<TextFieldC<>>("Text")->textField.buffer == "Saved");
+
+  // A failed write leaves the project unsaved
+  ec.persist.openedFilePath = "./res/missing/__GEN1__.rn";
+  ec.core.hasUnsavedChanges = true;
+  REQUIRE(ec.persist.saveProject(ec));
+  REQUIRE_FALSE(ec.persist.waitForSave(ec));
+  REQUIRE(ec.core.hasUnsavedChanges == true);
+}
+
+TEST_CASE("Test async project loading", "[Persist]") {
+  TestUtil::SetupCWD();
+  auto ec = TestUtil::getBasicContext();
+  constexpr int testSize = 2000;
+
+  for (const auto* testPath : {"./res/__GEN1__.rn", "./res/__GEN1__.rnb"}) {
+    ec.core.resetEditor(ec);
+    ec.persist.openedFilePath = testPath;
+    Node* prev = nullptr;
+    for (int i = 0; i < testSize; ++i) {
+      auto* node = ec.core.createAddNode(ec, "Text", {static_cast<float>(i), 5});
+      node->getComponent<TextFieldC<>>("Text")->textField.buffer = "Async";
+      if (prev) {
+        ec.core.addConnection(new Connection(*prev, prev->components[0], prev->components[0]->outputs[0], *node,
+                                             node->components[0], node->components[0]->inputs[0]));
+      }
+      prev = node;
+    }
+    ec.core.hasUnsavedChanges = true;
+    REQUIRE(ec.persist.saveProject(ec));
+    REQUIRE(ec.persist.waitForSave(ec));
+
+    REQUIRE(ec.persist.importProject(ec, true));
+    REQUIRE(ec.persist.isLoading());
+    REQUIRE_FALSE(ec.persist.saveProject(ec, false));  // Never saves a partial project
+
+    // Nodes are created over multiple ticks
+    float progress = 0.0F;
+    int ticks = 0;
+    while (ec.persist.isLoading()) {
+      ec.persist.update(ec);
+      REQUIRE(ec.persist.getLoadProgress() >= progress);
+      progress = ec.persist.getLoadProgress();
+      ticks++;
+    }
+    REQUIRE(ticks > 1);
+    REQUIRE(ec.core.nodes.size() == testSize);
+    REQUIRE(ec.core.connections.size() == testSize - 1);
+    REQUIRE(ec.core.getNode(NodeID(testSize - 1))->x == testSize - 1);
+    REQUIRE(ec.core.getNode(NodeID(7))->getComponent<TextFieldC<>>("Text")->textField.buffer == "Async");
+  }
+
+  // A missing file ends the import without touching the project
+  ec.persist.openedFilePath = "./res/missing/__GEN1__.rn";
+  REQUIRE(ec.persist.importProject(ec, true));
+  while (ec.persist.isLoading()) {
+    ec.persist.update(ec);
+  }
+  REQUIRE(ec.core.nodes.size() == testSize);
+}
+
+TEST_CASE("Test journal recovery", "[Persist]") {
+  TestUtil::SetupCWD();
+  auto* testPath = "./res/__GEN2__.rn";
+  const std::string journalPath = std::string(testPath) + Info::journalEnding;
+  auto ec = TestUtil::getBasicContext();
+  ec.persist.openedFilePath = testPath;
+  ec.persist.useJournal = true;
+
+  auto* text = ec.core.createAddNode(ec, "Text", {10, 20});
+  auto* display = ec.core.createAddNode(ec, "Text", {30, 40});
+  auto* removed = ec.core.createAddNode(ec, "Text", {50, 60});
+  ec.core.hasUnsavedChanges = true;
+  REQUIRE(ec.persist.saveProject(ec));
+  REQUIRE(ec.persist.waitForSave(ec));
+
+  // Changes after the save only go to the journal
+  auto* created = ec.core.createAddNode(ec, "Text", {70, 80});
+  auto* create = new NodeCreateAction(1);
+  create->createdNodes.push_back(created);
+  ec.core.addEditorAction(ec, create);
+
+  auto& buffer = text->getComponent<TextFieldC<>>("Text")->textField.buffer;
+  auto* edit = new TextAction(buffer, buffer);
+  buffer = "Journal";
+  edit->setAfter(buffer);
+  ec.logic.focusNode = text;
+  ec.core.addEditorAction(ec, edit);
+  ec.logic.focusNode = nullptr;
+
+  auto* move = new NodeMovedAction(1);
+  move->movedNodes.push_back({display->uID, {-270, 0}});
+  display->x = 300;
+  ec.core.addEditorAction(ec, move);
+
+  auto* conn = new Connection(*text, text->components[0], text->components[0]->outputs[0], *created,
+                              created->components[0], created->components[0]->inputs[0]);
+  auto* connect = new ConnectionCreateAction(1);
+  connect->createdConnections.push_back(conn);
+  ec.core.addEditorAction(ec, connect);
+  ec.core.addConnection(conn);
+
+  const std::unordered_map<NodeID, Node*> selected{{removed->uID, removed}};
+  ec.core.addEditorAction(ec, new NodeDeleteAction(ec, selected));
+  ec.core.undo(ec);
+  ec.core.redo(ec);
+
+  // Crash - the journal is left behind
+  ec.persist.closeJournal();
+  const auto journalSize = std::filesystem::file_size(journalPath);
+  REQUIRE(journalSize > 0);
+
+  // Headless imports neither replay nor remove it
+  auto headless = TestUtil::getBasicContext();
+  headless.persist.openedFilePath = testPath;
+  REQUIRE(headless.persist.importProject(headless));
+  REQUIRE(headless.persist.importProject(headless));
+  REQUIRE_FALSE(headless.core.hasUnsavedChanges);
+  REQUIRE(headless.core.nodes.size() == 3);
+  REQUIRE(headless.core.getNode(created->uID) == nullptr);
+  REQUIRE(std::filesystem::file_size(journalPath) == journalSize);
+
+  auto recovered = TestUtil::getBasicContext();
+  recovered.persist.openedFilePath = testPath;
+  recovered.persist.useJournal = true;
+  REQUIRE(recovered.persist.importProject(recovered));
+  REQUIRE(recovered.core.hasUnsavedChanges);
+  REQUIRE(recovered.core.nodes.size() == 3);
+  REQUIRE(recovered.core.connections.size() == 1);
+  REQUIRE(recovered.core.getNode(removed->uID) == nullptr);
+  REQUIRE(recovered.core.getNode(created->uID)->x == 70);
+  REQUIRE(recovered.core.getNode(display->uID)->x == 300);
+  REQUIRE(recovered.core.getNode(text->uID)->getComponent<TextFieldC<>>("Text")->textField.buffer == "Journal");
+  REQUIRE(&recovered.core.connections[0]->toNode == recovered.core.getNode(created->uID));
+
+  // Full saves compact the journal
+  REQUIRE(recovered.persist.saveProject(recovered));
+  REQUIRE(recovered.persist.waitForSave(recovered));
+  REQUIRE_FALSE(std::filesystem::exists(journalPath));
+  REQUIRE(recovered.persist.importProject(recovered));
+  REQUIRE_FALSE(recovered.core.hasUnsavedChanges);
+  REQUIRE(recovered.core.nodes.size() == 3);
+  REQUIRE(recovered.core.getNode(display->uID)->x == 300);
+
+  // Records after the snapshot survive the compaction
+  auto* last = recovered.core.createAddNode(recovered, "Text", {});
+  auto* lastCreate = new NodeCreateAction(1);
+  lastCreate->createdNodes.push_back(last);
+  recovered.core.addEditorAction(recovered, lastCreate);
+  REQUIRE(recovered.persist.saveProject(recovered));
+  recovered.core.undo(recovered);
+  REQUIRE(recovered.persist.waitForSave(recovered));
+  recovered.persist.closeJournal();
+  auto reopened = TestUtil::getBasicContext();
+  reopened.persist.openedFilePath = testPath;
+  reopened.persist.useJournal = true;
+  REQUIRE(reopened.persist.importProject(reopened));
+  REQUIRE(reopened.core.nodes.size() == 3);
+  REQUIRE(reopened.core.hasUnsavedChanges);
+
+  // Clean exits remove it
+  REQUIRE(std::filesystem::exists(journalPath));
+  reopened.persist.discardJournal();
+  REQUIRE_FALSE(std::filesystem::exists(journalPath));
+}
+
+TEST_CASE("Test binary project round trip", "[Persist]") {
+  TestUtil::SetupCWD();
+  auto* testPath = "./res/__GEN1__.rnb";
+  auto ec = TestUtil::getBasicContext();
+  ec.persist.openedFilePath = testPath;
+
+  auto* text = ec.core.createAddNode(ec, "Text", {150.5F, -250});
+  text->getComponent<TextFieldC<>>("Text")->textField.buffer = "Line1\nLine2";
+  auto* other = ec.core.createAddNode(ec, "Text", {400, 35});
+  other->getComponent<TextFieldC<>>("Text")->textField.buffer = "Line1\nLine2";
+  ec.core.createAddNode(ec, "Int", {})->getComponent<MathC>("Int")->selectedMode = 5;
+  auto vec3 = ec.core.createAddNode(ec, "Vec3", {})->getComponent<Vec3C<>>("Vec3")->textFields;
+  vec3[0].buffer = "3.141592", vec3[1].buffer = "-1.000000", vec3[2].buffer = "0.000000";
+  ec.core.addConnection(new Connection(*text, text->components[0], text->components[0]->outputs[0], *other,
+                                       other->components[0], other->components[0]->inputs[0]));
+  ec.core.nodeGroups.emplace_back(10.0F, 20.0F, "Group", true).addNode(ec, *other);
+
+  ec.core.hasUnsavedChanges = true;
+  REQUIRE(ec.persist.saveProject(ec));
+  ec.core.resetEditor(ec);
+  REQUIRE(ec.persist.importProject(ec));
+
+  REQUIRE(ec.core.nodes.size() == 4);
+  REQUIRE(ec.core.connections.size() == 1);
+  REQUIRE(ec.core.getNode(NodeID(0))->x == 150.5F);
+  REQUIRE(ec.core.getNode(NodeID(0))->y == -250);
+  REQUIRE(ec.core.getNode(NodeID(1))->getComponent<TextFieldC<>>("Text")->textField.buffer == "Line1\nLine2");
+  REQUIRE(ec.core.getNode(NodeID(2))->getComponent<MathC>("Int")->selectedMode == 5);
+  auto loaded = ec.core.getNode(NodeID(3))->getComponent<Vec3C<>>("Vec3")->textFields;
+  REQUIRE(loaded[0].buffer == "3.141592");
+  REQUIRE(loaded[1].buffer == "-1.000000");
+  REQUIRE(&ec.core.connections[0]->toNode == ec.core.getNode(NodeID(1)));
+  REQUIRE(ec.core.nodeGroups.size() == 1);
+  REQUIRE(ec.core.nodeGroups[0].nodes.size() == 1);
+  REQUIRE(strcmp(ec.core.nodeGroups[0].name, "Group") == 0);
+
+  // Same string is stored once
+  ByteReader reader;
+  REQUIRE(reader.open(testPath));
+  const std::string_view content{reader.data.data(), static_cast<size_t>(reader.end - reader.cursor)};
+  REQUIRE(content.starts_with("RNB"));
+  REQUIRE(content.find("Line1") == content.rfind("Line1"));
+}
+
+TEST_CASE("Test binary fallback to the text functions", "[Persist]") {
+  // Only implements the text functions
+  struct TextOnlyC final : Component {
+    int value = 0;
+    std::string name;
+    explicit TextOnlyC() : Component({"TextOnly", "TextOnly"}) {}
+    Component* clone() override { return new TextOnlyC(*this); }
+    void draw(EditorContext&, Node&) override {}
+    void update(EditorContext&, Node&) override {}
+    void save(FILE* file) override {
+      cxstructs::io_save(file, value);
+      cxstructs::io_save(file, name.c_str());
+    }
+    void load(FILE* file) override {
+      cxstructs::io_load(file, value);
+      cxstructs::io_load(file, name);
+    }
+  };
+
+  TextOnlyC saved;
+  saved.value = -42;
+  saved.name = "Fallback";
+  StringTable strings;
+  BinaryWriter writer{&strings};
+  static_cast<Component&>(saved).save(writer);
+  writer.writeInt(-7);
+
+  std::vector<std::string_view> views(strings.strings.begin(), strings.strings.end());
+  BinaryReader reader{writer.data.data(), writer.data.size(), &views};
+  TextOnlyC loaded;
+  static_cast<Component&>(loaded).load(reader);
+  REQUIRE(loaded.value == -42);
+  REQUIRE(loaded.name == "Fallback");
+  REQUIRE(reader.readInt() == -7);
+  REQUIRE(reader.isEOF());
+  REQUIRE_FALSE(reader.failed);
+
+  // Reading past the end is detected
+  reader.readVarint();
+  REQUIRE(reader.failed);
+}
+
 TEST_CASE("Benchmark saving and loading", "[Persist]") {
   TestUtil::SetupCWD();
   auto* testPath = "./res/__GEN2__.rn";
@@ -108,7 +490,7 @@ TEST_CASE("Benchmark saving and loading", "[Persist]") {
   ec.core.hasUnsavedChanges = true;
 
   BENCHMARK("Save") {
-    return ec.persist.saveProject(ec);
+    return ec.persist.saveProject(ec) && ec.persist.waitForSave(ec);
   };
 
   BENCHMARK("Load") {
@@ -116,4 +498,17 @@ TEST_CASE("Benchmark saving and loading", "[Persist]") {
   };
 
   REQUIRE(ec.core.nodes.size() == testSize);
+
+  ec.persist.openedFilePath = "./res/__GEN2__.rnb";
+  ec.core.hasUnsavedChanges = true;
+
+  BENCHMARK("Save binary") {
+    return ec.persist.saveProject(ec, false) && ec.persist.waitForSave(ec);
+  };
+
+  BENCHMARK("Load binary") {
+    return ec.persist.importProject(ec);
+  };
+
+  REQUIRE(ec.core.nodes.size() == testSize);
 }
\ No newline at end of file
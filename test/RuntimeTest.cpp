@@ -0,0 +1,182 @@
+// Copyright (c) 2024 gk646
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <catch_amalgamated.hpp>
+
+#include "TestUtil.h"
+#include "Runtime.h"
+#include "Logic/CompiledCircuit.h"
+#include "Logic/components/AndGateC.h"
+#include "Logic/components/BoolC.h"
+#include "Logic/components/BoolDisplayC.h"
+#include "Logic/components/NotGateC.h"
+#include "Logic/components/OrGateC.h"
+#include "Logic/components/XorGateC.h"
+
+namespace {
+void RegisterLogic(EditorContext& ec) {
+  PluginContainer pc{nullptr, "_Dummy_", nullptr};
+  NodeRegister nr{ec, pc};
+  ComponentRegister cr{ec, pc};
+  cr.registerComponent<BoolC<OUTPUT_ONLY>>("L_Bool_Out");
+  cr.registerComponent<NotGateC>("L_Not");
+  cr.registerComponent<AndGateC>("L_And");
+  cr.registerComponent<OrGateC>("L_Or");
+  cr.registerComponent<XorGateC>("L_Xor");
+  cr.registerComponent<BoolDisplayC>("L_Display");
+  nr.registerNode("Bool", {{"Bool", "L_Bool_Out"}});
+  nr.registerNode("NOT Gate", {{"Gate", "L_Not"}});
+  nr.registerNode("AND Gate", {{"Gate", "L_And"}});
+  nr.registerNode("OR Gate", {{"Gate", "L_Or"}});
+  nr.registerNode("XOR Gate", {{"Gate", "L_Xor"}});
+  nr.registerNode("Bool Display", {{"Display", "L_Display"}});
+}
+void Connect(EditorContext& ec, Node& from, Node& to, const int pin) {
+  auto* out = from.components[0];
+  auto* in = to.components[0];
+  ec.core.addConnection(new Connection(from, out, out->outputs[0], to, in, in->inputs[pin]));
+}
+bool GetBit(const std::vector<uint64_t>& column, const int row) {
+  return (column[row / 64] >> (row % 64) & 1) != 0;
+}
+}  // namespace
+
+TEST_CASE("Test headless stepping", "[Runtime]") {
+  Runtime runtime;
+  auto& ec = runtime.getContext();
+  RegisterLogic(ec);
+  constexpr int chainSize = 101;
+
+  auto* source = ec.core.createAddNode(ec, "Bool", {0, 0});
+  Node* prev = source;
+  for (int i = 0; i < chainSize; ++i) {
+    auto* gate = ec.core.createAddNode(ec, "NOT Gate", {0, 0});
+    auto* out = prev->components[0];
+    auto* in = gate->components[0];
+    ec.core.addConnection(new Connection(*prev, out, out->outputs[0], *gate, in, in->inputs[0]));
+    prev = gate;
+  }
+
+  auto* last = prev->components[0];
+  runtime.step();
+  REQUIRE(last->outputs[0].data.get<BOOLEAN>() == true);
+
+  // Odd amount of inverters
+  static_cast<BoolC<OUTPUT_ONLY>*>(source->components[0])->activeSwitch.isOn = true;
+  runtime.step();
+  REQUIRE(last->outputs[0].data.get<BOOLEAN>() == false);
+  REQUIRE(runtime.getTick() == 2);
+}
+
+TEST_CASE("Test headless project loading", "[Runtime]") {
+  TestUtil::SetupCWD();
+  Runtime runtime;
+  REQUIRE(runtime.loadPlugins(RN_PLUGIN_DIR));
+  REQUIRE(runtime.loadProject("res/Test1.rn"));
+  REQUIRE_FALSE(runtime.getContext().core.nodes.empty());
+
+  runtime.step(100);
+  REQUIRE(runtime.getTick() == 100);
+}
+
+TEST_CASE("Test compiled full adder truth table", "[Runtime]") {
+  Runtime runtime;
+  auto& ec = runtime.getContext();
+  RegisterLogic(ec);
+
+  auto* a = ec.core.createAddNode(ec, "Bool", {0, 0});
+  auto* b = ec.core.createAddNode(ec, "Bool", {0, 0});
+  auto* carryIn = ec.core.createAddNode(ec, "Bool", {0, 0});
+  auto* xor1 = ec.core.createAddNode(ec, "XOR Gate", {0, 0});
+  auto* xor2 = ec.core.createAddNode(ec, "XOR Gate", {0, 0});
+  auto* and1 = ec.core.createAddNode(ec, "AND Gate", {0, 0});
+  auto* and2 = ec.core.createAddNode(ec, "AND Gate", {0, 0});
+  auto* or1 = ec.core.createAddNode(ec, "OR Gate", {0, 0});
+  auto* sum = ec.core.createAddNode(ec, "Bool Display", {0, 0});
+  auto* carryOut = ec.core.createAddNode(ec, "Bool Display", {0, 0});
+
+  Connect(ec, *a, *xor1, 0);
+  Connect(ec, *b, *xor1, 1);
+  Connect(ec, *xor1, *xor2, 0);
+  Connect(ec, *carryIn, *xor2, 1);
+  Connect(ec, *a, *and1, 0);
+  Connect(ec, *b, *and1, 1);
+  Connect(ec, *xor1, *and2, 0);
+  Connect(ec, *carryIn, *and2, 1);
+  Connect(ec, *and1, *or1, 0);
+  Connect(ec, *and2, *or1, 1);
+  Connect(ec, *xor2, *sum, 0);
+  Connect(ec, *or1, *carryOut, 0);
+
+  CompiledCircuit circuit;
+  REQUIRE(circuit.compile(ec));
+  REQUIRE(circuit.inputs.size() == 3);
+  REQUIRE(circuit.outputs.size() == 2);
+  REQUIRE_FALSE(circuit.hasFeedback);
+
+  const auto table = circuit.truthTable();
+  REQUIRE(circuit.error == nullptr);
+  for (int row = 0; row < 8; ++row) {
+    const int total = (row & 1) + (row >> 1 & 1) + (row >> 2 & 1);
+    REQUIRE(GetBit(table[0], row) == ((total & 1) != 0));
+    REQUIRE(GetBit(table[1], row) == (total > 1));
+  }
+
+  // Nodes with more than a single logic component can't be compiled
+  PluginContainer pc{nullptr, "_Dummy_", nullptr};
+  NodeRegister nr{ec, pc};
+  nr.registerNode("Double NOT", {{"First", "L_Not"}, {"Second", "L_Not"}});
+  auto* unsupported = ec.core.createAddNode(ec, "Double NOT", {0, 0});
+  REQUIRE_FALSE(circuit.compile(ec));
+  REQUIRE(circuit.error != nullptr);
+  REQUIRE(circuit.rejectedNode == unsupported);
+}
+
+TEST_CASE("Test compiled circuit matches stepped simulation", "[Runtime]") {
+  TestUtil::SetupCWD();
+  Runtime runtime;
+  REQUIRE(runtime.loadPlugins(RN_PLUGIN_DIR));
+  REQUIRE(runtime.loadProject("../examples/logic/2BitFullAdder.rn"));
+
+  CompiledCircuit circuit;
+  REQUIRE(circuit.compile(runtime.getContext()));
+  const auto table = circuit.truthTable();
+  const int rows = 1 << circuit.inputs.size();
+
+  for (int row = 0; row < rows; ++row) {
+    for (size_t i = 0; i < circuit.inputNodes.size(); ++i) {
+      auto* c = circuit.inputNodes[i]->components[0];
+      const bool isOn = (row >> i & 1) != 0;
+      // Inputs are free L_Bool or L_Bool_Out components
+      if (strcmp(c->id, "L_Bool_Out") == 0) static_cast<BoolC<OUTPUT_ONLY>*>(c)->activeSwitch.isOn = isOn;
+      else static_cast<BoolC<>*>(c)->activeSwitch.isOn = isOn;
+    }
+    runtime.step(5);  // Connected bools forward their value one tick delayed
+    for (size_t o = 0; o < circuit.outputNodes.size(); ++o) {
+      auto* output = circuit.outputNodes[o]->components[0];
+      REQUIRE(output->outputs[0].data.get<BOOLEAN>() == GetBit(table[o], row));
+    }
+  }
+
+  BENCHMARK("Truth table") {
+    return circuit.truthTable();
+  };
+}
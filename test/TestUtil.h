@@ -25,6 +25,7 @@
 
 #include <random>
 
+#include "RnImport.h"
 #include "application/EditorContext.h"
 #include "plugin/RegisterInterface.h"
 #include "BuiltIns/components/TextFieldC.h"
@@ -57,6 +58,15 @@ inline EditorContext getBasicContext() {
   registerNodes(ec);
   return ec;
 }
+namespace {  // Internal linkage - ImportWideTest includes this with RN_WIDE_IDS
+// Imports a project from a copy of the string - the import owns and frees the copy
+inline raynodes::RnImport ImportFromString(const std::string& file, const bool fullIndex = false,
+                                           const int threads = 1) {
+  auto* data = static_cast<char*>(malloc(file.size() + 1));
+  std::memcpy(data, file.c_str(), file.size() + 1);
+  return raynodes::importRNFromMemory(data, static_cast<raynodes::ByteIndex>(file.size()), fullIndex, threads);
+}
+}  // namespace
 // Call this to use relative and short paths inside the test dir
 inline void SetupCWD() {
   char buff[256];